@@ -16,7 +16,14 @@
 #include "ofGraphics.h"
 #include "ofPixels.h"
 #include "ofImage.h"
+#include "ofLog.h"
 #include "ofVectorMath.h"
+#include "ofMesh.h"
+#include "ofPolyline.h"
+#include "ofSoundBuffer.h"
+
+#include "ofxZeroMQDepthCodec.h"
+#include "ofxZeroMQVertexCodec.h"
 
 /* standard layout types:
  * ofColor_<T>
@@ -29,7 +36,289 @@
  */
 
 namespace ofxZeroMQ {
+    struct ImageEncoding {
+        ofImageFormat format{OF_IMAGE_FORMAT_JPEG};
+        ofImageQualityType quality{OF_IMAGE_QUALITY_HIGH};
+    };
+
+    // send pixels compressed by ofSaveImage. receiver decodes it into ofPixels_ as usual.
+    // e.g. pub.sendMultipart("camera", ofxZeroMQ::encodeImage(grabber, ofxZeroMQ::ImageEncoding{OF_IMAGE_FORMAT_JPEG, OF_IMAGE_QUALITY_MEDIUM}));
+    template <typename pix_type>
+    struct EncodedPixels {
+        const ofPixels_<pix_type> *pixels{nullptr};
+        ImageEncoding encoding;
+    };
+
+    template <typename pix_type>
+    inline EncodedPixels<pix_type> encodeImage(const ofPixels_<pix_type> &pixels,
+                                               ImageEncoding encoding = ImageEncoding{})
+    { return { &pixels, encoding }; };
+
+    template <typename pix_type>
+    inline EncodedPixels<pix_type> encodeImage(const ofBaseHasPixels_<pix_type> &pixels,
+                                               ImageEncoding encoding = ImageEncoding{})
+    { return { &pixels.getPixels(), encoding }; };
+
+    // send depth pixels (e.g. ofShortPixels) compressed losslessly by RVL codec.
+    // receiver decodes it into ofPixels_ as usual.
+    // e.g. pub.sendMultipart("depth", ofxZeroMQ::encodeDepth(kinect.getRawDepthPixels()));
+    template <typename pix_type>
+    struct DepthPixels {
+        const ofPixels_<pix_type> *pixels{nullptr};
+    };
+
+    template <typename pix_type>
+    inline DepthPixels<pix_type> encodeDepth(const ofPixels_<pix_type> &pixels)
+    { return { &pixels }; };
+
+    // send float vector arrays / ofMesh / ofPolyline with quantization.
+    // e.g. pub.sendMultipart("particles", ofxZeroMQ::quantize(positions, ofxZeroMQ::Quantization::BoundedInt16));
+    // ofMesh / ofPolyline are received as usual. vector arrays are received by ofxZeroMQ::dequantize.
+    template <typename vec_type>
+    struct QuantizedArray {
+        const std::vector<vec_type> *values{nullptr};
+        Quantization quantization{Quantization::Half};
+    };
+
+    template <typename vec_type>
+    inline QuantizedArray<vec_type> quantize(const std::vector<vec_type> &values,
+                                             Quantization quantization = Quantization::Half)
+    { return { &values, quantization }; };
+
+    struct QuantizedMesh {
+        const ofMesh *mesh{nullptr};
+        Quantization quantization{Quantization::Half};
+    };
+
+    inline QuantizedMesh quantize(const ofMesh &mesh,
+                                  Quantization quantization = Quantization::Half)
+    { return { &mesh, quantization }; };
+
+    struct QuantizedPolyline {
+        const ofPolyline *polyline{nullptr};
+        Quantization quantization{Quantization::Half};
+    };
+
+    inline QuantizedPolyline quantize(const ofPolyline &polyline,
+                                      Quantization quantization = Quantization::Half)
+    { return { &polyline, quantization }; };
+
     namespace detail {
+        // encoded image frame: [std::uint32_t magic][encoded bytes].
+        // magic is placed where raw frame has width, so it never conflicts with actual width.
+        static constexpr std::uint32_t encoded_image_magic = 0x495A464F; // "OFZI"
+
+        inline bool has_magic(const zmq::message_t &m, std::uint32_t magic) {
+            std::uint32_t head;
+            if(m.size() < sizeof(head)) return false;
+            std::memcpy(&head, m.data(), sizeof(head));
+            return head == magic;
+        }
+
+        template <typename pix_type>
+        inline bool encode_image(Message &m,
+                                 const ofPixels_<pix_type> &pix,
+                                 ImageEncoding encoding)
+        {
+            ofBuffer buffer;
+            if(!ofSaveImage(pix, buffer, encoding.format, encoding.quality)) {
+                ofLogWarning("ofxZeroMQ") << "failed to encode image";
+                return false;
+            }
+            m.rebuild(sizeof(encoded_image_magic) + buffer.size());
+            std::memcpy(m.data(), &encoded_image_magic, sizeof(encoded_image_magic));
+            std::memcpy((char *)m.data() + sizeof(encoded_image_magic), buffer.getData(), buffer.size());
+            return true;
+        }
+
+        template <typename pix_type>
+        inline bool decode_image(const Message &m,
+                                 ofPixels_<pix_type> &pix)
+        {
+            ofBuffer buffer;
+            buffer.set((const char *)m.data() + sizeof(encoded_image_magic), m.size() - sizeof(encoded_image_magic));
+            if(!ofLoadImage(pix, buffer)) {
+                ofLogWarning("ofxZeroMQ") << "failed to decode image";
+                return false;
+            }
+            return true;
+        }
+
+        // depth frame: [std::uint32_t magic][std::uint32_t width, height][ofPixelFormat][std::uint32_t bytes per channel][rvl words]
+        static constexpr std::uint32_t encoded_depth_magic = 0x445A464F; // "OFZD"
+
+        template <typename pix_type>
+        inline void encode_depth(Message &m,
+                                 const ofPixels_<pix_type> &pix)
+        {
+            thread_local std::vector<std::uint32_t> words;
+            rvl_encode(pix.getData(), pix.size(), words);
+
+            const std::uint32_t header[4] = {
+                encoded_depth_magic,
+                static_cast<std::uint32_t>(pix.getWidth()),
+                static_cast<std::uint32_t>(pix.getHeight()),
+                static_cast<std::uint32_t>(sizeof(pix_type))
+            };
+            const ofPixelFormat pixel_format = pix.getPixelFormat();
+            m.rebuild(sizeof(header) + sizeof(pixel_format) + words.size() * sizeof(std::uint32_t));
+            auto offset = m.copyFrom(header);
+            offset += m.copyFrom(pixel_format, offset);
+            m.memCopyFrom(words.data(), words.size() * sizeof(std::uint32_t), offset);
+        }
+
+        template <typename pix_type>
+        inline bool decode_depth(const Message &m,
+                                 ofPixels_<pix_type> &pix)
+        {
+            std::uint32_t header[4];
+            ofPixelFormat pixel_format;
+            if(m.size() < sizeof(header) + sizeof(pixel_format)) return false;
+            auto offset = m.copyTo(header);
+            offset += m.copyTo(pixel_format, offset);
+            if(header[3] != sizeof(pix_type)) {
+                ofLogWarning("ofxZeroMQ") << "depth frame has " << header[3] << " bytes per channel, but receiving pixels has " << sizeof(pix_type);
+                return false;
+            }
+            pix.allocate(header[1], header[2], pixel_format);
+            if(!rvl_decode((const char *)m.data() + offset,
+                           (m.size() - offset) / sizeof(std::uint32_t),
+                           pix.getData(),
+                           pix.size()))
+            {
+                ofLogWarning("ofxZeroMQ") << "broken depth frame";
+                return false;
+            }
+            return true;
+        }
+
+        // vector array frame: [std::uint32_t magic][vertex section]
+        // mesh frame: [std::uint32_t magic][ofPrimitiveMode][vertices][normals][colors][texcoords][std::uint32_t num_indices][indices]
+        // polyline frame: [std::uint32_t magic][std::uint32_t is_closed][vertices]
+        static constexpr std::uint32_t vector_array_magic = 0x565A464F; // "OFZV"
+        static constexpr std::uint32_t mesh_magic = 0x4D5A464F; // "OFZM"
+        static constexpr std::uint32_t polyline_magic = 0x505A464F; // "OFZP"
+
+        template <typename vec_type>
+        inline std::size_t vector_components() {
+            static_assert(std::is_standard_layout<vec_type>::value
+                          && sizeof(vec_type) % sizeof(float) == 0
+                          && sizeof(vec_type) <= sizeof(float) * 4,
+                          "quantization supports only float vector types up to 4 components");
+            return sizeof(vec_type) / sizeof(float);
+        }
+
+        template <typename vec_type>
+        inline std::size_t vertex_section_size(const std::vector<vec_type> &values,
+                                               Quantization quantization)
+        { return vertex_section_size(values.size(), vector_components<vec_type>(), quantization); };
+
+        template <typename vec_type>
+        inline std::size_t write_vertex_section(char *dst,
+                                                const std::vector<vec_type> &values,
+                                                Quantization quantization)
+        {
+            return write_vertex_section(dst,
+                                        reinterpret_cast<const float *>(values.data()),
+                                        values.size(),
+                                        vector_components<vec_type>(),
+                                        quantization);
+        }
+
+        // return read size, 0 if broken
+        template <typename vec_type>
+        inline std::size_t read_vertex_section(const char *src,
+                                               std::size_t available,
+                                               std::vector<vec_type> &values)
+        {
+            std::size_t count, components;
+            Quantization quantization;
+            if(!peek_vertex_section(src, available, count, components, quantization)
+               || components != vector_components<vec_type>())
+            {
+                return 0;
+            }
+            values.resize(count);
+            return read_vertex_section(src, available, reinterpret_cast<float *>(values.data()));
+        }
+
+        inline void encode_mesh(Message &m,
+                                const ofMesh &mesh,
+                                Quantization quantization)
+        {
+            const auto &indices = mesh.getIndices();
+            const std::uint32_t header[2] = {
+                mesh_magic,
+                static_cast<std::uint32_t>(mesh.getMode())
+            };
+            const std::uint32_t num_indices = static_cast<std::uint32_t>(indices.size());
+            m.rebuild(sizeof(header)
+                      + vertex_section_size(mesh.getVertices(), quantization)
+                      + vertex_section_size(mesh.getNormals(), quantization)
+                      + vertex_section_size(mesh.getColors(), quantization)
+                      + vertex_section_size(mesh.getTexCoords(), quantization)
+                      + sizeof(num_indices)
+                      + sizeof(std::uint32_t) * indices.size());
+            char *p = static_cast<char *>(m.data());
+            std::memcpy(p, header, sizeof(header));
+            p += sizeof(header);
+            p += write_vertex_section(p, mesh.getVertices(), quantization);
+            p += write_vertex_section(p, mesh.getNormals(), quantization);
+            p += write_vertex_section(p, mesh.getColors(), quantization);
+            p += write_vertex_section(p, mesh.getTexCoords(), quantization);
+            std::memcpy(p, &num_indices, sizeof(num_indices));
+            p += sizeof(num_indices);
+            for(auto index : indices) {
+                const std::uint32_t i = static_cast<std::uint32_t>(index);
+                std::memcpy(p, &i, sizeof(i));
+                p += sizeof(i);
+            }
+        }
+
+        // vertices, normals, colors, tex coords and indices after header. return false if broken
+        inline bool decode_mesh_sections(const char *p,
+                                         const char *end,
+                                         ofMesh &mesh)
+        {
+            std::size_t read_size;
+            if(!(read_size = read_vertex_section(p, end - p, mesh.getVertices()))) return false;
+            p += read_size;
+            if(!(read_size = read_vertex_section(p, end - p, mesh.getNormals()))) return false;
+            p += read_size;
+            if(!(read_size = read_vertex_section(p, end - p, mesh.getColors()))) return false;
+            p += read_size;
+            if(!(read_size = read_vertex_section(p, end - p, mesh.getTexCoords()))) return false;
+            p += read_size;
+
+            std::uint32_t num_indices;
+            if(static_cast<std::size_t>(end - p) < sizeof(num_indices)) return false;
+            std::memcpy(&num_indices, p, sizeof(num_indices));
+            p += sizeof(num_indices);
+            if(static_cast<std::size_t>(end - p) / sizeof(std::uint32_t) < num_indices) return false;
+            auto &indices = mesh.getIndices();
+            indices.resize(num_indices);
+            for(auto &index : indices) {
+                std::uint32_t i;
+                std::memcpy(&i, p, sizeof(i));
+                p += sizeof(i);
+                index = static_cast<ofIndexType>(i);
+            }
+            return true;
+        }
+
+        inline void encode_polyline(Message &m,
+                                    const ofPolyline &polyline,
+                                    Quantization quantization)
+        {
+            const std::uint32_t header[2] = {
+                polyline_magic,
+                polyline.isClosed() ? 1u : 0u
+            };
+            m.rebuild(sizeof(header) + vertex_section_size(polyline.getVertices(), quantization));
+            std::memcpy(m.data(), header, sizeof(header));
+            write_vertex_section(static_cast<char *>(m.data()) + sizeof(header), polyline.getVertices(), quantization);
+        }
+
 #pragma mark ofBuffer
         inline static void to_zmq_message(Message &m,
                                           const ofBuffer &data)
@@ -74,6 +363,14 @@ namespace ofxZeroMQ {
         inline static void from_zmq_message(const Message &m,
                                             ofPixels_<pix_type> &pix)
         {
+            if(has_magic(m, encoded_image_magic)) {
+                decode_image(m, pix);
+                return;
+            }
+            if(has_magic(m, encoded_depth_magic)) {
+                decode_depth(m, pix);
+                return;
+            }
             std::uint32_t size[2];
             ofPixelFormat pixel_format;
             auto offset = m.copyTo(size);
@@ -84,6 +381,119 @@ namespace ofxZeroMQ {
                               pixel_format);
         }
 
+#pragma mark EncodedPixels
+        template <typename pix_type>
+        inline static void to_zmq_message(Message &m,
+                                          const EncodedPixels<pix_type> &encoded)
+        { if(encoded.pixels) encode_image(m, *encoded.pixels, encoded.encoding); };
+
+#pragma mark DepthPixels
+        template <typename pix_type>
+        inline static void to_zmq_message(Message &m,
+                                          const DepthPixels<pix_type> &depth)
+        { if(depth.pixels) encode_depth(m, *depth.pixels); };
+
+#pragma mark QuantizedArray
+        template <typename vec_type>
+        inline static void to_zmq_message(Message &m,
+                                          const QuantizedArray<vec_type> &quantized)
+        {
+            if(!quantized.values) return;
+            m.rebuild(sizeof(vector_array_magic) + vertex_section_size(*quantized.values, quantized.quantization));
+            std::memcpy(m.data(), &vector_array_magic, sizeof(vector_array_magic));
+            write_vertex_section(static_cast<char *>(m.data()) + sizeof(vector_array_magic), *quantized.values, quantized.quantization);
+        }
+
+#pragma mark ofMesh
+        inline static void to_zmq_message(Message &m,
+                                          const ofMesh &mesh)
+        { encode_mesh(m, mesh, Quantization::None); };
+
+        inline static void to_zmq_message(Message &m,
+                                          const QuantizedMesh &quantized)
+        { if(quantized.mesh) encode_mesh(m, *quantized.mesh, quantized.quantization); };
+
+        inline static void from_zmq_message(const Message &m,
+                                            ofMesh &mesh)
+        {
+            std::uint32_t header[2];
+            if(m.size() < sizeof(header) || !has_magic(m, mesh_magic)) {
+                ofLogWarning("ofxZeroMQ") << "not a mesh frame";
+                return;
+            }
+            std::memcpy(header, m.data(), sizeof(header));
+            mesh.clear();
+            mesh.setMode(static_cast<ofPrimitiveMode>(header[1]));
+
+            const char *data = static_cast<const char *>(m.data());
+            if(!decode_mesh_sections(data + sizeof(header), data + m.size(), mesh)) {
+                ofLogWarning("ofxZeroMQ") << "broken mesh frame";
+                mesh.clear();
+            }
+        }
+
+#pragma mark ofPolyline
+        inline static void to_zmq_message(Message &m,
+                                          const ofPolyline &polyline)
+        { encode_polyline(m, polyline, Quantization::None); };
+
+        inline static void to_zmq_message(Message &m,
+                                          const QuantizedPolyline &quantized)
+        { if(quantized.polyline) encode_polyline(m, *quantized.polyline, quantized.quantization); };
+
+        inline static void from_zmq_message(const Message &m,
+                                            ofPolyline &polyline)
+        {
+            std::uint32_t header[2];
+            if(m.size() < sizeof(header) || !has_magic(m, polyline_magic)) {
+                ofLogWarning("ofxZeroMQ") << "not a polyline frame";
+                return;
+            }
+            std::memcpy(header, m.data(), sizeof(header));
+            polyline.clear();
+            if(!read_vertex_section(static_cast<const char *>(m.data()) + sizeof(header),
+                                    m.size() - sizeof(header),
+                                    polyline.getVertices()))
+            {
+                ofLogWarning("ofxZeroMQ") << "broken polyline frame";
+                polyline.clear();
+            }
+            polyline.setClosed(header[1] != 0);
+            polyline.flagHasChanged();
+        }
+
+#pragma mark ofSoundBuffer
+        // [std::uint32_t num_channels][std::uint32_t sample_rate][std::uint64_t tick_count][interleaved float samples]
+        inline static void to_zmq_message(Message &m,
+                                          const ofSoundBuffer &buffer)
+        {
+            const std::uint32_t format[2] = {
+                static_cast<std::uint32_t>(buffer.getNumChannels()),
+                static_cast<std::uint32_t>(buffer.getSampleRate())
+            };
+            const std::uint64_t tick_count = buffer.getTickCount();
+            m.rebuild(sizeof(format) + sizeof(tick_count) + sizeof(float) * buffer.size());
+            auto offset = m.copyFrom(format);
+            offset += m.copyFrom(tick_count, offset);
+            m.memCopyFrom(buffer.getBuffer().data(), sizeof(float) * buffer.size(), offset);
+        }
+
+        inline static void from_zmq_message(const Message &m,
+                                            ofSoundBuffer &buffer)
+        {
+            std::uint32_t format[2];
+            std::uint64_t tick_count;
+            if(m.size() < sizeof(format) + sizeof(tick_count)) return;
+            auto offset = m.copyTo(format);
+            offset += m.copyTo(tick_count, offset);
+            const std::size_t num_channels = 0 < format[0] ? format[0] : 1;
+            const std::size_t num_frames = (m.size() - offset) / sizeof(float) / num_channels;
+            buffer.setSampleRate(format[1]);
+            buffer.allocate(num_frames, num_channels);
+            buffer.setTickCount(tick_count);
+            std::memcpy(buffer.getBuffer().data(), (const char *)m.data() + offset, sizeof(float) * num_frames * num_channels);
+        }
+
 #pragma mark ofBaseHasPixels
         template <typename pix_type>
         inline static void to_zmq_message(Message &m,
@@ -95,6 +505,17 @@ namespace ofxZeroMQ {
                                             ofBaseHasPixels_<pix_type> &pix)
         { from_zmq_message(m, pix.getPixels()); };
     }; // detail
+
+    // receive vector array sent by quantize. return false if message is not quantized array
+    template <typename vec_type>
+    inline bool dequantize(const zmq::message_t &m,
+                           std::vector<vec_type> &values)
+    {
+        if(!detail::has_magic(m, detail::vector_array_magic)) return false;
+        return 0 < detail::read_vertex_section(static_cast<const char *>(m.data()) + sizeof(detail::vector_array_magic),
+                                               m.size() - sizeof(detail::vector_array_magic),
+                                               values);
+    }
 }; // ofxZeroMQ
 
 #endif /* ofxZeroMQConvertFunctions_h */
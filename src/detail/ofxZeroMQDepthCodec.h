@@ -0,0 +1,223 @@
+//
+//  ofxZeroMQDepthCodec.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQDepthCodec_h
+#define ofxZeroMQDepthCodec_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/* RVL (run length / variable length) lossless depth codec.
+ * A. D. Wilson, "Fast Lossless Depth Image Compression", ISS 2017.
+ *
+ * pixels are scanned as runs of [zeros][non-zeros].
+ * each run length and zigzag encoded delta from previous non-zero value are
+ * written as variable length code in 4bit nibbles (3bit value + continue bit),
+ * packed 8 nibbles into one std::uint32_t word.
+ * 0 is treated as invalid depth, so sparse / holed depth frames compress well.
+ * pixel values are treated as raw bits, so float depth is also lossless.
+ */
+
+namespace ofxZeroMQ {
+    namespace detail {
+        struct rvl_writer {
+            rvl_writer(std::vector<std::uint32_t> &words)
+            : words(words)
+            {};
+
+            inline void put_vle(std::uint64_t value) {
+                if(value < small_table_size) {
+                    const std::uint16_t entry = small_table()[value];
+                    put_nibbles(entry & 0xFFF, entry >> 12);
+                    return;
+                }
+                std::uint64_t code = 0;
+                int num_nibbles = 0;
+                do {
+                    std::uint64_t nibble = value & 0x7;
+                    value >>= 3;
+                    if(value) nibble |= 0x8;
+                    code = (code << 4) | nibble;
+                    ++num_nibbles;
+                } while(value);
+                if(7 < num_nibbles) {
+                    put_nibbles(code >> 28, num_nibbles - 7);
+                    put_nibbles(code & 0xFFFFFFF, 7);
+                } else {
+                    put_nibbles(code, num_nibbles);
+                }
+            }
+
+            void flush() {
+                if(num_bits == 0) return;
+                words.push_back(static_cast<std::uint32_t>(bits << (32 - num_bits)));
+                bits = 0;
+                num_bits = 0;
+            }
+
+        private:
+            // codes of values less than 512 (up to 3 nibbles): [num_nibbles:4][code:12]
+            static constexpr std::size_t small_table_size = 512;
+            static const std::uint16_t *small_table() {
+                struct table {
+                    table() {
+                        for(std::uint32_t v = 0; v < small_table_size; ++v) {
+                            std::uint32_t value = v, code = 0, num_nibbles = 0;
+                            do {
+                                std::uint32_t nibble = value & 0x7;
+                                value >>= 3;
+                                if(value) nibble |= 0x8;
+                                code = (code << 4) | nibble;
+                                ++num_nibbles;
+                            } while(value);
+                            entries[v] = static_cast<std::uint16_t>((num_nibbles << 12) | code);
+                        }
+                    }
+                    std::uint16_t entries[small_table_size];
+                };
+                static const table t;
+                return t.entries;
+            }
+
+            // num_nibbles <= 7, so bits never overflows
+            inline void put_nibbles(std::uint64_t code, int num_nibbles) {
+                bits = (bits << (4 * num_nibbles)) | code;
+                num_bits += 4 * num_nibbles;
+                if(32 <= num_bits) {
+                    num_bits -= 32;
+                    words.push_back(static_cast<std::uint32_t>(bits >> num_bits));
+                }
+            }
+
+            std::vector<std::uint32_t> &words;
+            std::uint64_t bits{0};
+            int num_bits{0};
+        };
+
+        struct rvl_reader {
+            rvl_reader(const void *data, std::size_t num_words)
+            : cursor(static_cast<const char *>(data))
+            , end(static_cast<const char *>(data) + num_words * sizeof(std::uint32_t))
+            {};
+
+            inline std::uint64_t get_vle() {
+                refill();
+                std::uint64_t value = 0;
+                int shift = 0;
+                std::uint64_t nibble;
+                do {
+                    if(num_bits < 4) {
+                        refill();
+                        if(num_bits < 4) {
+                            is_overrun = true;
+                            return 0;
+                        }
+                    }
+                    nibble = bits >> 60;
+                    bits <<= 4;
+                    num_bits -= 4;
+                    value |= (nibble & 0x7) << shift;
+                    shift += 3;
+                } while((nibble & 0x8) && shift < 64);
+                return value;
+            }
+
+            bool is_overrun{false};
+
+        private:
+            // bits are left aligned
+            inline void refill() {
+                if(32 < num_bits || cursor == end) return;
+                std::uint32_t word;
+                std::memcpy(&word, cursor, sizeof(word));
+                cursor += sizeof(word);
+                bits |= static_cast<std::uint64_t>(word) << (32 - num_bits);
+                num_bits += 32;
+            }
+
+            const char *cursor;
+            const char *end;
+            std::uint64_t bits{0};
+            int num_bits{0};
+        };
+
+        template <typename pix_type>
+        inline std::uint32_t rvl_bits(const pix_type &v) {
+            static_assert(sizeof(pix_type) <= sizeof(std::uint32_t), "rvl supports only pixel types up to 32bit");
+            std::uint32_t bits = 0;
+            std::memcpy(&bits, &v, sizeof(pix_type));
+            return bits;
+        }
+
+        template <typename pix_type>
+        inline pix_type rvl_value(std::uint32_t bits) {
+            pix_type v;
+            std::memcpy(&v, &bits, sizeof(pix_type));
+            return v;
+        }
+
+        template <typename pix_type>
+        void rvl_encode(const pix_type *pixels,
+                        std::size_t num_pixels,
+                        std::vector<std::uint32_t> &words)
+        {
+            words.clear();
+            words.reserve(num_pixels / 4 + 1);
+            rvl_writer writer{words};
+            std::int64_t previous = 0;
+            std::size_t i = 0;
+            while(i < num_pixels) {
+                const std::size_t zeros_begin = i;
+                while(i < num_pixels && rvl_bits(pixels[i]) == 0) ++i;
+                writer.put_vle(i - zeros_begin);
+
+                const std::size_t nonzeros_begin = i;
+                while(i < num_pixels && rvl_bits(pixels[i]) != 0) ++i;
+                writer.put_vle(i - nonzeros_begin);
+
+                for(std::size_t j = nonzeros_begin; j < i; ++j) {
+                    const std::int64_t current = rvl_bits(pixels[j]);
+                    const std::int64_t delta = current - previous;
+                    writer.put_vle((static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63));
+                    previous = current;
+                }
+            }
+            writer.flush();
+        }
+
+        // return false if data is broken
+        template <typename pix_type>
+        bool rvl_decode(const void *data,
+                        std::size_t num_words,
+                        pix_type *pixels,
+                        std::size_t num_pixels)
+        {
+            rvl_reader reader{data, num_words};
+            std::int64_t previous = 0;
+            std::size_t i = 0;
+            while(i < num_pixels && !reader.is_overrun) {
+                const std::uint64_t num_zeros = reader.get_vle();
+                if(num_pixels - i < num_zeros) return false;
+                std::memset(pixels + i, 0, num_zeros * sizeof(pix_type));
+                i += num_zeros;
+
+                const std::uint64_t num_nonzeros = reader.get_vle();
+                if(num_pixels - i < num_nonzeros) return false;
+                for(const std::size_t end = i + num_nonzeros; i < end; ++i) {
+                    const std::uint64_t zigzag = reader.get_vle();
+                    const std::int64_t delta = static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+                    previous += delta;
+                    pixels[i] = rvl_value<pix_type>(static_cast<std::uint32_t>(previous));
+                }
+            }
+            return i == num_pixels && !reader.is_overrun;
+        }
+    }; // detail
+}; // ofxZeroMQ
+
+#endif /* ofxZeroMQDepthCodec_h */
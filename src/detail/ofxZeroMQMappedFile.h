@@ -0,0 +1,230 @@
+//
+//  ofxZeroMQMappedFile.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQMappedFile_h
+#define ofxZeroMQMappedFile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#endif
+
+#include "ofLog.h"
+
+namespace ofxZeroMQ {
+    namespace detail {
+        // unaligned access to mapped file records
+        inline std::uint64_t read_u64(const char *p) {
+            std::uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        inline void write_u64(char *p, std::uint64_t v)
+        { std::memcpy(p, &v, sizeof(v)); };
+        inline std::uint32_t read_u32(const char *p) {
+            std::uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        inline void write_u32(char *p, std::uint32_t v)
+        { std::memcpy(p, &v, sizeof(v)); };
+
+        // read / write memory mapped file. file is extended to given size.
+        struct mapped_file {
+            mapped_file() = default;
+            mapped_file(const mapped_file &) = delete;
+            mapped_file &operator=(const mapped_file &) = delete;
+            mapped_file(mapped_file &&v) noexcept
+            { swap(v); };
+            mapped_file &operator=(mapped_file &&v) noexcept {
+                close();
+                swap(v);
+                return *this;
+            }
+
+            ~mapped_file()
+            { close(); };
+
+            // if size is 0, map whole existing file
+            bool open(const std::string &path, std::size_t size = 0) {
+                close();
+#ifdef _WIN32
+                file = ::CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if(file == INVALID_HANDLE_VALUE) return fail(path, "CreateFile");
+                LARGE_INTEGER current;
+                ::GetFileSizeEx(file, &current);
+                if(size == 0) size = static_cast<std::size_t>(current.QuadPart);
+                if(size == 0) return fail(path, "empty file");
+                LARGE_INTEGER large_size;
+                large_size.QuadPart = static_cast<LONGLONG>(size);
+                mapping = ::CreateFileMappingA(file, nullptr, PAGE_READWRITE, large_size.HighPart, large_size.LowPart, nullptr);
+                if(mapping == nullptr) return fail(path, "CreateFileMapping");
+                ptr = static_cast<char *>(::MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+                if(ptr == nullptr) return fail(path, "MapViewOfFile");
+#else
+                fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+                if(fd < 0) return fail(path, "open");
+                struct stat st;
+                if(::fstat(fd, &st) != 0) return fail(path, "fstat");
+                if(size == 0) size = static_cast<std::size_t>(st.st_size);
+                if(size == 0) return fail(path, "empty file");
+                if(static_cast<std::size_t>(st.st_size) < size && ::ftruncate(fd, static_cast<off_t>(size)) != 0) return fail(path, "ftruncate");
+                void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if(p == MAP_FAILED) return fail(path, "mmap");
+                ptr = static_cast<char *>(p);
+#endif
+                mapped_size = size;
+                opened_path = path;
+                return true;
+            }
+
+            // map whole existing file without write permission, e.g. archived or shipped file.
+            // data() must not be written, and resize fails
+            bool openReadOnly(const std::string &path) {
+                close();
+                std::size_t size = 0;
+#ifdef _WIN32
+                file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if(file == INVALID_HANDLE_VALUE) return fail(path, "CreateFile");
+                LARGE_INTEGER current;
+                ::GetFileSizeEx(file, &current);
+                size = static_cast<std::size_t>(current.QuadPart);
+                if(size == 0) return fail(path, "empty file");
+                mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if(mapping == nullptr) return fail(path, "CreateFileMapping");
+                ptr = static_cast<char *>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size));
+                if(ptr == nullptr) return fail(path, "MapViewOfFile");
+#else
+                fd = ::open(path.c_str(), O_RDONLY);
+                if(fd < 0) return fail(path, "open");
+                struct stat st;
+                if(::fstat(fd, &st) != 0) return fail(path, "fstat");
+                size = static_cast<std::size_t>(st.st_size);
+                if(size == 0) return fail(path, "empty file");
+                void *p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+                if(p == MAP_FAILED) return fail(path, "mmap");
+                ptr = static_cast<char *>(p);
+#endif
+                mapped_size = size;
+                opened_path = path;
+                is_read_only = true;
+                return true;
+            }
+
+            // remap with new size. file is extended or truncated. data() may change
+            bool resize(std::size_t size) {
+                if(ptr == nullptr || size == 0 || is_read_only) return false;
+#ifdef _WIN32
+                ::UnmapViewOfFile(ptr);
+                ::CloseHandle(mapping);
+                ptr = nullptr;
+                mapping = nullptr;
+                LARGE_INTEGER large_size;
+                large_size.QuadPart = static_cast<LONGLONG>(size);
+                if(!::SetFilePointerEx(file, large_size, nullptr, FILE_BEGIN) || !::SetEndOfFile(file)) return fail(opened_path, "SetEndOfFile");
+                mapping = ::CreateFileMappingA(file, nullptr, PAGE_READWRITE, large_size.HighPart, large_size.LowPart, nullptr);
+                if(mapping == nullptr) return fail(opened_path, "CreateFileMapping");
+                ptr = static_cast<char *>(::MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+                if(ptr == nullptr) return fail(opened_path, "MapViewOfFile");
+#else
+                ::munmap(ptr, mapped_size);
+                ptr = nullptr;
+                if(::ftruncate(fd, static_cast<off_t>(size)) != 0) return fail(opened_path, "ftruncate");
+                void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if(p == MAP_FAILED) return fail(opened_path, "mmap");
+                ptr = static_cast<char *>(p);
+#endif
+                mapped_size = size;
+                return true;
+            }
+
+            void close() {
+#ifdef _WIN32
+                if(ptr) ::UnmapViewOfFile(ptr);
+                if(mapping) ::CloseHandle(mapping);
+                if(file != INVALID_HANDLE_VALUE) ::CloseHandle(file);
+                mapping = nullptr;
+                file = INVALID_HANDLE_VALUE;
+#else
+                if(ptr) ::munmap(ptr, mapped_size);
+                if(0 <= fd) ::close(fd);
+                fd = -1;
+#endif
+                ptr = nullptr;
+                mapped_size = 0;
+                is_read_only = false;
+            }
+
+            // write back dirty pages asynchronously
+            void flush() {
+                if(ptr == nullptr || is_read_only) return;
+#ifdef _WIN32
+                ::FlushViewOfFile(ptr, 0);
+#else
+                ::msync(ptr, mapped_size, MS_ASYNC);
+#endif
+            }
+
+            bool isOpen() const
+            { return ptr != nullptr; };
+            bool isReadOnly() const
+            { return is_read_only; };
+            char *data()
+            { return ptr; };
+            const char *data() const
+            { return ptr; };
+            std::size_t size() const
+            { return mapped_size; };
+
+        private:
+            bool fail(const std::string &path, const char *what) {
+                ofLogError("ofxZeroMQ::mapped_file") << what << " failed: " << path;
+                close();
+                return false;
+            }
+
+            void swap(mapped_file &v) noexcept {
+                std::swap(ptr, v.ptr);
+                std::swap(mapped_size, v.mapped_size);
+                std::swap(opened_path, v.opened_path);
+                std::swap(is_read_only, v.is_read_only);
+#ifdef _WIN32
+                std::swap(file, v.file);
+                std::swap(mapping, v.mapping);
+#else
+                std::swap(fd, v.fd);
+#endif
+            }
+
+            char *ptr{nullptr};
+            std::size_t mapped_size{0};
+            std::string opened_path;
+            bool is_read_only{false};
+#ifdef _WIN32
+            HANDLE file{INVALID_HANDLE_VALUE};
+            HANDLE mapping{nullptr};
+#else
+            int fd{-1};
+#endif
+        };
+    }; // detail
+}; // ofxZeroMQ
+
+#endif /* ofxZeroMQMappedFile_h */
@@ -0,0 +1,224 @@
+//
+//  ofxZeroMQRateLimit.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQRateLimit_h
+#define ofxZeroMQRateLimit_h
+
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+
+namespace ofxZeroMQ {
+    namespace detail {
+        inline bool has_prefix(const void *data, std::size_t size, const std::string &prefix)
+        { return prefix.size() <= size && std::memcmp(data, prefix.data(), prefix.size()) == 0; };
+
+        // rule of longest prefix which matches to topic, or end
+        template <typename rules_type>
+        auto find_longest_prefix(rules_type &rules, const void *data, std::size_t size) -> decltype(rules.end()) {
+            auto found = rules.end();
+            for(auto it = rules.begin(); it != rules.end(); ++it) {
+                if(!has_prefix(data, size, it->prefix)) continue;
+                if(found == rules.end() || found->prefix.size() < it->prefix.size()) found = it;
+            }
+            return found;
+        }
+
+        template <typename rules_type>
+        bool erase_prefix(rules_type &rules, const std::string &prefix) {
+            auto it = std::find_if(rules.begin(), rules.end(), [&prefix](const typename rules_type::value_type &rule) { return rule.prefix == prefix; });
+            if(it == rules.end()) return false;
+            rules.erase(it);
+            return true;
+        }
+
+        // token bucket per topic prefix. topics which match no prefix are not limited.
+        struct topic_rate_limiter {
+            using clock = std::chrono::steady_clock;
+
+            void set(const std::string &prefix, float messages_per_second, float burst) {
+                auto it = std::find_if(buckets.begin(), buckets.end(), [&prefix](const bucket &b) { return b.prefix == prefix; });
+                if(it == buckets.end()) {
+                    buckets.emplace_back();
+                    buckets.back().prefix = prefix;
+                    it = buckets.end() - 1;
+                }
+                it->rate = std::max(messages_per_second, 0.0f);
+                it->burst = std::max(burst, 1.0f);
+                it->tokens = it->burst;
+                it->updated = clock::now();
+            }
+            bool remove(const std::string &prefix)
+            { return erase_prefix(buckets, prefix); };
+            bool empty() const
+            { return buckets.empty(); };
+
+            // return false if message of this topic has to be dropped
+            bool acquire(const void *topic, std::size_t size) {
+                auto it = find_longest_prefix(buckets, topic, size);
+                if(it == buckets.end()) return true;
+                const auto now = clock::now();
+                it->tokens = std::min(it->burst, it->tokens + it->rate * std::chrono::duration<float>(now - it->updated).count());
+                it->updated = now;
+                if(it->tokens < 1.0f) {
+                    ++num_dropped;
+                    return false;
+                }
+                it->tokens -= 1.0f;
+                return true;
+            }
+
+            std::uint64_t num_dropped{0};
+
+        private:
+            struct bucket {
+                std::string prefix;
+                float rate{0.0f};
+                float burst{1.0f};
+                float tokens{1.0f};
+                clock::time_point updated;
+            };
+            std::vector<bucket> buckets;
+        };
+
+        // keeps every Nth message, or latest message in each interval, of each topic (first frame) matching prefix.
+        // topics which match no prefix pass through.
+        struct topic_decimator {
+            using clock = std::chrono::steady_clock;
+
+            void setEveryN(const std::string &prefix, std::uint32_t every_n) {
+                rule &r = get_rule(prefix);
+                release_all(r);
+                r.every_n = std::max(every_n, 1u);
+                r.interval = clock::duration::zero();
+            }
+            void setInterval(const std::string &prefix, float seconds) {
+                rule &r = get_rule(prefix);
+                r.every_n = 0;
+                r.interval = std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(std::max(seconds, 0.0f)));
+            }
+            bool remove(const std::string &prefix) {
+                auto it = std::find_if(rules.begin(), rules.end(), [&prefix](const rule &r) { return r.prefix == prefix; });
+                if(it == rules.end()) return false;
+                // held messages are not lost
+                release_all(*it);
+                rules.erase(it);
+                return true;
+            }
+            bool empty() const
+            { return rules.empty(); };
+
+            // message is moved to ready queue, held as latest of its topic in interval, or dropped
+            void offer(zmq::multipart_t &message) {
+                auto it = message.empty() ? rules.end() : find_longest_prefix(rules, message.front().data(), message.front().size());
+                if(it == rules.end()) {
+                    ready.push_back(std::move(message));
+                } else if(it->every_n) {
+                    // counted per topic, so each topic of prefix keeps its every Nth message
+                    held &h = get_held(*it, message.front());
+                    if(h.count++ % it->every_n == 0) ready.push_back(std::move(message));
+                    else ++num_dropped;
+                } else {
+                    held &h = get_held(*it, message.front());
+                    if(h.has_latest) ++num_dropped;
+                    h.latest = std::move(message);
+                    h.has_latest = true;
+                }
+                message.clear();
+            }
+
+            // move latest messages whose interval is elapsed to ready queue
+            void release() {
+                const auto now = clock::now();
+                for(auto &r : rules) {
+                    for(auto &h : r.topics) {
+                        if(!h.has_latest || now - h.last_delivered < r.interval) continue;
+                        ready.push_back(std::move(h.latest));
+                        h.has_latest = false;
+                        h.last_delivered = now;
+                    }
+                }
+            }
+
+            bool pop(zmq::multipart_t &message) {
+                if(ready.empty()) return false;
+                message = std::move(ready.front());
+                ready.pop_front();
+                return true;
+            }
+
+            bool hasReady() const
+            { return !ready.empty(); };
+
+            // time until next held message is released. clock::duration::max() if nothing is held
+            clock::duration getTimeToRelease() const {
+                const auto now = clock::now();
+                clock::duration wait = clock::duration::max();
+                for(const auto &r : rules) {
+                    for(const auto &h : r.topics) {
+                        if(!h.has_latest) continue;
+                        wait = std::min(wait, std::max(clock::duration::zero(), h.last_delivered + r.interval - now));
+                    }
+                }
+                return wait;
+            }
+
+            std::uint64_t num_dropped{0};
+
+        private:
+            // state of one topic. kept after delivery, so number of topics should be bounded
+            struct held {
+                std::string topic;
+                clock::time_point last_delivered;
+                zmq::multipart_t latest;
+                bool has_latest{false};
+                std::uint64_t count{0};
+            };
+
+            struct rule {
+                std::string prefix;
+                std::uint32_t every_n{1};
+                clock::duration interval{};
+                std::vector<held> topics;
+            };
+
+            rule &get_rule(const std::string &prefix) {
+                auto it = std::find_if(rules.begin(), rules.end(), [&prefix](const rule &r) { return r.prefix == prefix; });
+                if(it != rules.end()) return *it;
+                rules.emplace_back();
+                rules.back().prefix = prefix;
+                return rules.back();
+            }
+
+            // allocates only when topic is seen first time
+            held &get_held(rule &r, const zmq::message_t &topic) {
+                for(auto &h : r.topics) {
+                    if(h.topic.size() == topic.size() && std::memcmp(h.topic.data(), topic.data(), topic.size()) == 0) return h;
+                }
+                r.topics.emplace_back();
+                r.topics.back().topic.assign(static_cast<const char *>(topic.data()), topic.size());
+                return r.topics.back();
+            }
+
+            void release_all(rule &r) {
+                for(auto &h : r.topics) if(h.has_latest) ready.push_back(std::move(h.latest));
+                r.topics.clear();
+            }
+
+            std::vector<rule> rules;
+            std::deque<zmq::multipart_t> ready;
+        };
+    }; // detail
+}; // ofxZeroMQ
+
+#endif /* ofxZeroMQRateLimit_h */
@@ -0,0 +1,171 @@
+//
+//  ofxZeroMQReactor.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQReactor_h
+#define ofxZeroMQReactor_h
+
+#if defined(__has_include)
+#   if __has_include(<coroutine>) && defined(__cpp_impl_coroutine) && (201902L <= __cpp_impl_coroutine)
+#       define OFX_ZEROMQ_HAS_COROUTINE 1
+#   endif
+#endif
+
+#ifndef OFX_ZEROMQ_HAS_COROUTINE
+#   define OFX_ZEROMQ_HAS_COROUTINE 0
+#endif
+
+#if OFX_ZEROMQ_HAS_COROUTINE
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+#include <algorithm>
+
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+
+#include "ofLog.h"
+
+/* usage:
+ *
+ * ofxZeroMQReactor reactor;
+ * ofxZeroMQSubscriber sub;
+ *
+ * ofxZeroMQ::Task listen() {
+ *     while(true) {
+ *         ofxZeroMQMultipartMessage m;
+ *         co_await sub.asyncReceive(reactor, m);
+ *         ...
+ *     }
+ * }
+ *
+ * void ofApp::update() { reactor.poll(); }
+ */
+
+namespace ofxZeroMQ {
+#pragma mark - Task
+    // fire-and-forget coroutine. starts eagerly and frees itself on completion.
+    struct Task {
+        struct promise_type {
+            Task get_return_object() noexcept
+            { return {}; };
+            std::suspend_never initial_suspend() noexcept
+            { return {}; };
+            std::suspend_never final_suspend() noexcept
+            { return {}; };
+            void return_void() noexcept {};
+            void unhandled_exception() noexcept {
+                try {
+                    std::rethrow_exception(std::current_exception());
+                } catch(const std::exception &e) {
+                    ofLogError("ofxZeroMQ::Task") << "unhandled exception: " << e.what();
+                } catch(...) {
+                    ofLogError("ofxZeroMQ::Task") << "unhandled unknown exception";
+                }
+            }
+        };
+    }; // Task
+
+#pragma mark - Reactor
+    struct Reactor {
+        struct Operation {
+            virtual ~Operation() = default;
+            // must not block. return true when operation is done.
+            virtual bool tryComplete() = 0;
+
+            zmq::socket_t *socket{nullptr};
+            short events{ZMQ_POLLIN};
+            std::coroutine_handle<> handle;
+        };
+
+        Reactor() = default;
+        Reactor(const Reactor &) = delete;
+        Reactor &operator=(const Reactor &) = delete;
+
+        ~Reactor() {
+            // suspended coroutines can't be resumed anymore.
+            auto ops = std::move(pending);
+            for(auto op : ops) op->handle.destroy();
+        }
+
+        void post(Operation *op)
+        { pending.push_back(op); };
+
+        // wait readiness of sockets used by pending operations, and resume coroutines of completed operations.
+        // timeout_millis = 0: don't block (call from ofApp::update), -1: block until any operation completes.
+        std::size_t poll(long timeout_millis = 0) {
+            if(pending.empty()) return 0;
+
+            items.resize(pending.size());
+            for(std::size_t i = 0; i < pending.size(); ++i) {
+                items[i].socket = static_cast<void *>(*pending[i]->socket);
+                items[i].fd = 0;
+                items[i].events = pending[i]->events;
+                items[i].revents = 0;
+            }
+            if(zmq::poll(items.data(), items.size(), timeout_millis) <= 0) return 0;
+
+            ready.clear();
+            std::size_t num_waiting = 0;
+            for(std::size_t i = 0; i < pending.size(); ++i) {
+                Operation *op = pending[i];
+                if(items[i].revents != 0 && op->tryComplete()) {
+                    ready.push_back(op);
+                } else {
+                    pending[num_waiting++] = op;
+                }
+            }
+            pending.resize(num_waiting);
+
+            // resumed coroutines may post new operations, so resume after bookkeeping.
+            auto resumables = std::move(ready);
+            ready.clear();
+            for(auto op : resumables) op->handle.resume();
+            return resumables.size();
+        }
+
+        // run until all pending operations are completed
+        void run()
+        { while(!pending.empty()) poll(-1); };
+
+        bool empty() const
+        { return pending.empty(); };
+        std::size_t size() const
+        { return pending.size(); };
+
+    private:
+        std::vector<Operation *> pending;
+        std::vector<Operation *> ready;
+        std::vector<zmq::pollitem_t> items;
+    }; // Reactor
+
+    namespace detail {
+        struct awaitable_operation : Reactor::Operation {
+            awaitable_operation(Reactor &reactor,
+                                zmq::socket_t &socket,
+                                short events)
+            : reactor(reactor)
+            {
+                this->socket = &socket;
+                this->events = events;
+            };
+
+            bool await_ready()
+            { return tryComplete(); };
+            void await_suspend(std::coroutine_handle<> h) {
+                handle = h;
+                reactor.post(this);
+            }
+
+        protected:
+            Reactor &reactor;
+        };
+    }; // detail
+}; // ofxZeroMQ
+
+#endif // OFX_ZEROMQ_HAS_COROUTINE
+
+#endif /* ofxZeroMQReactor_h */
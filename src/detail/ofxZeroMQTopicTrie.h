@@ -0,0 +1,169 @@
+//
+//  ofxZeroMQTopicTrie.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQTopicTrie_h
+#define ofxZeroMQTopicTrie_h
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ofxZeroMQ {
+    namespace detail {
+        // radix tree of topic prefixes (like radix_tree.cpp of libzmq).
+        // each edge has label of one or more bytes, and children are distinguished by first byte of their labels.
+        // match walks edges along topic, so it is O(topic length) and doesn't allocate.
+        template <typename value_type>
+        struct topic_trie {
+            // return false if prefix already has value (value is replaced)
+            bool insert(const std::string &prefix, value_type value) {
+                node *n = &root;
+                std::size_t pos = 0;
+                while(pos < prefix.size()) {
+                    node *child = n->find_child(prefix[pos]);
+                    if(child == nullptr) {
+                        n->children.emplace_back(new node(prefix.substr(pos)));
+                        n = n->children.back().get();
+                        pos = prefix.size();
+                        break;
+                    }
+                    const std::size_t common = common_length(child->label, prefix.data() + pos, prefix.size() - pos);
+                    if(common < child->label.size()) child->split(common);
+                    n = child;
+                    pos += common;
+                }
+                const bool is_new = !n->has_value;
+                n->value = std::move(value);
+                n->has_value = true;
+                if(is_new) ++num_values;
+                return is_new;
+            }
+
+            // return false if prefix has no value
+            bool erase(const std::string &prefix) {
+                if(!erase(root, prefix.data(), prefix.size())) return false;
+                --num_values;
+                return true;
+            }
+
+            // nullptr if prefix has no value
+            value_type *find(const std::string &prefix) {
+                node *n = &root;
+                std::size_t pos = 0;
+                while(pos < prefix.size()) {
+                    n = n->find_child(prefix[pos]);
+                    if(n == nullptr || prefix.size() - pos < n->label.size() || prefix.compare(pos, n->label.size(), n->label) != 0) return nullptr;
+                    pos += n->label.size();
+                }
+                return n->has_value ? &n->value : nullptr;
+            }
+
+            // call function with value of each prefix of topic, from shortest to longest.
+            // return number of matched prefixes
+            template <typename function_type>
+            std::size_t match(const void *topic, std::size_t size, function_type &&function) {
+                const char *data = static_cast<const char *>(topic);
+                std::size_t num = 0;
+                node *n = &root;
+                std::size_t pos = 0;
+                while(true) {
+                    if(n->has_value) {
+                        function(n->value);
+                        ++num;
+                    }
+                    if(pos == size) break;
+                    n = n->find_child(data[pos]);
+                    if(n == nullptr || size - pos < n->label.size() || std::memcmp(data + pos, n->label.data(), n->label.size()) != 0) break;
+                    pos += n->label.size();
+                }
+                return num;
+            }
+
+            std::size_t size() const
+            { return num_values; };
+            bool empty() const
+            { return num_values == 0; };
+            void clear() {
+                root.children.clear();
+                root.value = value_type{};
+                root.has_value = false;
+                num_values = 0;
+            }
+
+        private:
+            struct node {
+                node() {};
+                node(std::string label)
+                : label(std::move(label))
+                {};
+
+                node *find_child(char first) {
+                    for(auto &child : children) if(child->label[0] == first) return child.get();
+                    return nullptr;
+                }
+
+                // move tail of label and everything below to new child
+                void split(std::size_t at) {
+                    std::unique_ptr<node> tail{new node(label.substr(at))};
+                    tail->children.swap(children);
+                    tail->value = std::move(value);
+                    tail->has_value = has_value;
+                    value = value_type{};
+                    has_value = false;
+                    label.resize(at);
+                    children.push_back(std::move(tail));
+                }
+
+                // merge only child which is left after erase
+                void merge_child() {
+                    std::unique_ptr<node> child = std::move(children.front());
+                    label += child->label;
+                    children.swap(child->children);
+                    value = std::move(child->value);
+                    has_value = child->has_value;
+                }
+
+                std::string label;
+                std::vector<std::unique_ptr<node>> children;
+                value_type value{};
+                bool has_value{false};
+            };
+
+            static std::size_t common_length(const std::string &label, const char *data, std::size_t size) {
+                std::size_t i = 0;
+                while(i < label.size() && i < size && label[i] == data[i]) ++i;
+                return i;
+            }
+
+            // remove value, then prune empty nodes and merge nodes which have only one child
+            static bool erase(node &n, const char *prefix, std::size_t size) {
+                if(size == 0) {
+                    if(!n.has_value) return false;
+                    n.value = value_type{};
+                    n.has_value = false;
+                    return true;
+                }
+                for(auto it = n.children.begin(); it != n.children.end(); ++it) {
+                    node &child = **it;
+                    if(child.label[0] != prefix[0]) continue;
+                    if(size < child.label.size() || child.label.compare(0, child.label.size(), prefix, child.label.size()) != 0) return false;
+                    if(!erase(child, prefix + child.label.size(), size - child.label.size())) return false;
+                    if(!child.has_value && child.children.empty()) n.children.erase(it);
+                    else if(!child.has_value && child.children.size() == 1) child.merge_child();
+                    return true;
+                }
+                return false;
+            }
+
+            node root;
+            std::size_t num_values{0};
+        };
+    }; // detail
+}; // ofxZeroMQ
+
+#endif /* ofxZeroMQTopicTrie_h */
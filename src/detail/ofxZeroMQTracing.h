@@ -0,0 +1,318 @@
+//
+//  ofxZeroMQTracing.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQTracing_h
+#define ofxZeroMQTracing_h
+
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+namespace ofxZeroMQ {
+    namespace detail {
+        inline std::int64_t now_nanos() {
+            using namespace std::chrono;
+            return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+        }
+
+        // index of most significant bit. v must be non zero.
+        inline std::uint32_t highest_bit(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+            return 63u - static_cast<std::uint32_t>(__builtin_clzll(v));
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanReverse64(&index, v);
+            return static_cast<std::uint32_t>(index);
+#else
+            std::uint32_t index = 0;
+            while(v >>= 1) ++index;
+            return index;
+#endif
+        }
+
+        // FNV-1a 64bit
+        inline std::uint64_t fnv1a_hash(const void *data, std::size_t size) {
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            for(std::size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+    }; // detail
+
+#pragma mark - LatencyHistogram
+    struct LatencyPercentiles {
+        std::uint64_t count{0};
+        std::int64_t min{0};
+        std::int64_t p50{0};
+        std::int64_t p99{0};
+        std::int64_t p999{0};
+        std::int64_t max{0};
+    };
+
+    // HdrHistogram style log-linear histogram of nanoseconds.
+    // values are exact under 64ns and have ~3% relative error above.
+    // record is a few instructions without allocation. not thread safe.
+    struct LatencyHistogram {
+        static constexpr std::uint32_t sub_bucket_bits = 6;
+        static constexpr std::uint32_t sub_bucket_count = 1u << sub_bucket_bits;
+        static constexpr std::uint32_t sub_bucket_half_count = sub_bucket_count / 2;
+        static constexpr std::uint32_t max_value_bits = 40; // about 18 minutes
+        static constexpr std::size_t bucket_size = (max_value_bits - sub_bucket_bits + 2) * sub_bucket_half_count;
+
+        LatencyHistogram()
+        : counts(bucket_size, 0)
+        {};
+
+        void record(std::int64_t nanos) {
+            std::uint64_t v = nanos < 0 ? 0 : static_cast<std::uint64_t>(nanos);
+            ++counts[index_of(v)];
+            ++count;
+            if(v < min_value) min_value = v;
+            if(max_value < v) max_value = v;
+        }
+
+        std::uint64_t getCount() const
+        { return count; };
+        std::int64_t getMin() const
+        { return count ? static_cast<std::int64_t>(min_value) : 0; };
+        std::int64_t getMax() const
+        { return static_cast<std::int64_t>(max_value); };
+
+        // percentile is in [0, 100]
+        std::int64_t getValueAtPercentile(double percentile) const {
+            if(count == 0) return 0;
+            if(100.0 <= percentile) return getMax();
+            std::uint64_t threshold = static_cast<std::uint64_t>(percentile / 100.0 * count + 0.5);
+            if(threshold < 1) threshold = 1;
+            std::uint64_t accumulated = 0;
+            for(std::size_t i = 0; i < counts.size(); ++i) {
+                accumulated += counts[i];
+                if(threshold <= accumulated) {
+                    auto v = highest_equivalent_value(i);
+                    return static_cast<std::int64_t>(v < max_value ? v : max_value);
+                }
+            }
+            return getMax();
+        }
+
+        LatencyPercentiles getPercentiles() const {
+            LatencyPercentiles p;
+            p.count = count;
+            p.min = getMin();
+            p.p50 = getValueAtPercentile(50.0);
+            p.p99 = getValueAtPercentile(99.0);
+            p.p999 = getValueAtPercentile(99.9);
+            p.max = getMax();
+            return p;
+        }
+
+        void reset() {
+            std::fill(counts.begin(), counts.end(), 0);
+            count = 0;
+            min_value = std::numeric_limits<std::uint64_t>::max();
+            max_value = 0;
+        }
+
+    private:
+        static std::size_t index_of(std::uint64_t v) {
+            if(v < sub_bucket_count) return static_cast<std::size_t>(v);
+            std::uint32_t msb = detail::highest_bit(v);
+            if(max_value_bits <= msb) return bucket_size - 1;
+            std::uint32_t shift = msb - sub_bucket_bits + 1;
+            return shift * sub_bucket_half_count + static_cast<std::size_t>(v >> shift);
+        }
+
+        static std::uint64_t highest_equivalent_value(std::size_t index) {
+            if(index < sub_bucket_count) return index;
+            std::uint64_t shift = (index - sub_bucket_half_count) / sub_bucket_half_count;
+            std::uint64_t sub = index - shift * sub_bucket_half_count;
+            return ((sub + 1) << shift) - 1;
+        }
+
+        std::vector<std::uint64_t> counts;
+        std::uint64_t count{0};
+        std::uint64_t min_value{std::numeric_limits<std::uint64_t>::max()};
+        std::uint64_t max_value{0};
+    };
+
+#pragma mark - trace frame
+    namespace detail {
+        /* trace frame is appended as last part of multipart message:
+         * std::uint32_t magic
+         * std::uint32_t num_stamps
+         * std::int64_t stamps[num_stamps] // steady clock nanoseconds. [0]: publisher, [1...]: proxies
+         * steady clock is only comparable between processes on the same host.
+         */
+        static constexpr std::uint32_t trace_frame_magic = 0x747A666Fu; // "ofzt"
+        static constexpr std::size_t trace_frame_header_size = sizeof(std::uint32_t) * 2;
+
+        inline zmq::message_t make_trace_frame() {
+            zmq::message_t m(trace_frame_header_size + sizeof(std::int64_t));
+            const std::uint32_t header[2] = { trace_frame_magic, 1u };
+            const std::int64_t stamp = now_nanos();
+            std::memcpy(m.data(), header, sizeof(header));
+            std::memcpy((char *)m.data() + sizeof(header), &stamp, sizeof(stamp));
+            return m;
+        }
+
+        inline std::uint32_t num_trace_stamps(const zmq::message_t &m) {
+            if(m.size() < trace_frame_header_size + sizeof(std::int64_t)) return 0;
+            std::uint32_t header[2];
+            std::memcpy(header, m.data(), sizeof(header));
+            if(header[0] != trace_frame_magic) return 0;
+            if(m.size() != trace_frame_header_size + sizeof(std::int64_t) * header[1]) return 0;
+            return header[1];
+        }
+
+        inline bool is_trace_frame(const zmq::message_t &m)
+        { return 0 < num_trace_stamps(m); };
+
+        inline std::int64_t trace_stamp(const zmq::message_t &m, std::size_t index) {
+            std::int64_t stamp;
+            std::memcpy(&stamp, (const char *)m.data() + trace_frame_header_size + sizeof(std::int64_t) * index, sizeof(stamp));
+            return stamp;
+        }
+
+        // add hop stamp if the last part of message is trace frame
+        inline void add_trace_hop(zmq::multipart_t &message) {
+            if(message.empty()) return;
+            const std::uint32_t num = num_trace_stamps(message.back());
+            if(num == 0) return;
+            zmq::message_t traced = message.remove();
+            zmq::message_t m(traced.size() + sizeof(std::int64_t));
+            std::memcpy(m.data(), traced.data(), traced.size());
+            const std::uint32_t new_num = num + 1;
+            const std::int64_t stamp = now_nanos();
+            std::memcpy((char *)m.data() + sizeof(std::uint32_t), &new_num, sizeof(new_num));
+            std::memcpy((char *)m.data() + traced.size(), &stamp, sizeof(stamp));
+            message.add(std::move(m));
+        }
+    }; // detail
+
+#pragma mark - LatencyTracer
+    struct LatencyTracer {
+        enum class Mode {
+            Stamp,     // publisher side: append trace frame
+            Record,    // subscriber side: strip trace frame and record latency per topic
+            RoundTrip, // request side: record round trip time locally
+        };
+
+        LatencyTracer(Mode mode)
+        : mode(mode)
+        {};
+
+        Mode getMode() const
+        { return mode; };
+
+        void onSend(zmq::multipart_t &message) {
+            if(mode == Mode::Stamp) message.add(detail::make_trace_frame());
+            else if(mode == Mode::RoundTrip) sent_time = detail::now_nanos();
+        }
+
+        void onReceive(zmq::multipart_t &message) {
+            if(message.empty()) return;
+            if(mode == Mode::RoundTrip) {
+                onReply();
+                return;
+            }
+            if(mode != Mode::Record) return;
+            const std::int64_t now = detail::now_nanos();
+            const std::uint32_t num = detail::num_trace_stamps(message.back());
+            if(num == 0) return;
+            zmq::message_t traced = message.remove();
+            const std::int64_t latency = now - detail::trace_stamp(traced, 0);
+            total.record(latency);
+            if(message.empty()) histogram_of("", 0).record(latency);
+            else histogram_of(message.front().data(), message.front().size()).record(latency);
+
+            if(hops.size() < num) hops.resize(num);
+            for(std::uint32_t i = 0; i + 1 < num; ++i) {
+                hops[i].record(detail::trace_stamp(traced, i + 1) - detail::trace_stamp(traced, i));
+            }
+            hops[num - 1].record(now - detail::trace_stamp(traced, num - 1));
+        }
+
+        // for RoundTrip mode. called when last part of reply is received
+        void onReply() {
+            if(mode != Mode::RoundTrip || sent_time == 0) return;
+            record("", detail::now_nanos() - sent_time);
+            sent_time = 0;
+        }
+
+        void record(const std::string &topic, std::int64_t nanos) {
+            total.record(nanos);
+            histogram_of(topic.data(), topic.size()).record(nanos);
+        }
+
+        const LatencyHistogram &getTotalHistogram() const
+        { return total; };
+
+        // key is first frame of message as topic. for RoundTrip mode, key is always ""
+        const std::unordered_map<std::string, LatencyHistogram> &getHistograms() const
+        { return histograms; };
+
+        // latency of each hop. [0]: publisher -> (first proxy or subscriber), ...
+        const std::vector<LatencyHistogram> &getHopHistograms() const
+        { return hops; };
+
+        std::map<std::string, LatencyPercentiles> getPercentiles() const {
+            std::map<std::string, LatencyPercentiles> result;
+            for(const auto &pair : histograms) result[pair.first] = pair.second.getPercentiles();
+            return result;
+        }
+
+        void reset() {
+            total.reset();
+            histograms.clear();
+            histogram_index.clear();
+            hops.clear();
+        }
+
+    private:
+        using histogram_map = std::unordered_map<std::string, LatencyHistogram>;
+
+        // finds histogram by hash of topic bytes, so no string is built per message.
+        // allocates only when topic is seen first time
+        LatencyHistogram &histogram_of(const void *topic, std::size_t size) {
+            const std::uint64_t hash = detail::fnv1a_hash(topic, size);
+            auto range = histogram_index.equal_range(hash);
+            for(auto it = range.first; it != range.second; ++it) {
+                const std::string &key = it->second->first;
+                if(key.size() == size && std::memcmp(key.data(), topic, size) == 0) return it->second->second;
+            }
+            // pointers to elements of unordered_map are stable on rehash
+            histogram_map::value_type &entry = *histograms.emplace(std::string{static_cast<const char *>(topic), size}, LatencyHistogram{}).first;
+            histogram_index.emplace(hash, &entry);
+            return entry.second;
+        }
+
+        Mode mode;
+        std::int64_t sent_time{0};
+        LatencyHistogram total;
+        histogram_map histograms;
+        std::unordered_multimap<std::uint64_t, histogram_map::value_type *> histogram_index;
+        std::vector<LatencyHistogram> hops;
+    };
+}; // ofxZeroMQ
+
+#endif /* ofxZeroMQTracing_h */
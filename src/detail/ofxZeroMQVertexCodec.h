@@ -0,0 +1,295 @@
+//
+//  ofxZeroMQVertexCodec.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQVertexCodec_h
+#define ofxZeroMQVertexCodec_h
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__)
+#   include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#   include <arm_neon.h>
+#endif
+
+namespace ofxZeroMQ {
+    enum class Quantization : std::uint8_t {
+        // 32bit float as is
+        None = 0,
+        // IEEE 754 half float. ~3 significant digits, relative error
+        Half = 1,
+        // 16bit unsigned int between min / max of each component. absolute error is (max - min) / 65535
+        BoundedInt16 = 2,
+    };
+
+    namespace detail {
+#pragma mark half float
+        // round to nearest even. F. Giesen, "float->half variants"
+        inline std::uint16_t float_to_half(float value) {
+            std::uint32_t x;
+            std::memcpy(&x, &value, sizeof(x));
+            const std::uint32_t sign = x & 0x80000000u;
+            x ^= sign;
+            std::uint16_t h;
+            if(0x47800000u <= x) {
+                // inf or nan
+                h = 0x7F800000u < x ? 0x7E00 : 0x7C00;
+            } else if(x < 0x38800000u) {
+                // subnormal or zero
+                static constexpr std::uint32_t denorm_magic_bits = ((127 - 15) + (23 - 10) + 1) << 23;
+                float denorm_magic, f;
+                std::memcpy(&denorm_magic, &denorm_magic_bits, sizeof(denorm_magic));
+                std::memcpy(&f, &x, sizeof(f));
+                f += denorm_magic;
+                std::uint32_t bits;
+                std::memcpy(&bits, &f, sizeof(bits));
+                h = static_cast<std::uint16_t>(bits - denorm_magic_bits);
+            } else {
+                const std::uint32_t mantissa_odd = (x >> 13) & 1;
+                // rebias exponent (15 - 127) and round
+                x += 0xC8000FFFu + mantissa_odd;
+                h = static_cast<std::uint16_t>(x >> 13);
+            }
+            return static_cast<std::uint16_t>((sign >> 16) | h);
+        }
+
+        inline float half_to_float(std::uint16_t h) {
+            static constexpr std::uint32_t shifted_exp = 0x7C00u << 13;
+            std::uint32_t bits = (h & 0x7FFFu) << 13;
+            const std::uint32_t exp = shifted_exp & bits;
+            bits += (127 - 15) << 23;
+            if(exp == shifted_exp) {
+                // inf or nan
+                bits += (128 - 16) << 23;
+            } else if(exp == 0) {
+                // subnormal
+                static constexpr std::uint32_t magic_bits = 113 << 23;
+                float magic, f;
+                std::memcpy(&magic, &magic_bits, sizeof(magic));
+                bits += 1 << 23;
+                std::memcpy(&f, &bits, sizeof(f));
+                f -= magic;
+                std::memcpy(&bits, &f, sizeof(bits));
+            }
+            bits |= static_cast<std::uint32_t>(h & 0x8000u) << 16;
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        // hardware conversion (F16C on x86, NEON on arm64) if available when compiled
+        inline void floats_to_halfs(const float *src, std::uint16_t *dst, std::size_t num) {
+            std::size_t i = 0;
+#if defined(__F16C__)
+            for(; i + 8 <= num; i += 8) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                                 _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+            }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            for(; i + 4 <= num; i += 4) {
+                vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+            }
+#endif
+            for(; i < num; ++i) dst[i] = float_to_half(src[i]);
+        }
+
+        inline void halfs_to_floats(const std::uint16_t *src, float *dst, std::size_t num) {
+            std::size_t i = 0;
+#if defined(__F16C__)
+            for(; i + 8 <= num; i += 8) {
+                _mm256_storeu_ps(dst + i,
+                                 _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))));
+            }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            for(; i + 4 <= num; i += 4) {
+                vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+            }
+#endif
+            for(; i < num; ++i) dst[i] = half_to_float(src[i]);
+        }
+
+#pragma mark bounded int16
+        // values are processed in blocks of 12 (lcm of 1 - 4 components) to be auto vectorized
+        static constexpr std::size_t bounded_block_size = 12;
+
+        inline void floats_to_bounded(const float *src,
+                                      std::uint16_t *dst,
+                                      std::size_t num,
+                                      std::size_t components,
+                                      const float *min,
+                                      const float *max)
+        {
+            float offset[bounded_block_size], scale[bounded_block_size];
+            for(std::size_t j = 0; j < bounded_block_size; ++j) {
+                const std::size_t c = j % components;
+                offset[j] = min[c];
+                scale[j] = min[c] < max[c] ? 65535.0f / (max[c] - min[c]) : 0.0f;
+            }
+            std::size_t i = 0;
+            for(; i + bounded_block_size <= num; i += bounded_block_size) {
+                for(std::size_t j = 0; j < bounded_block_size; ++j) {
+                    const float q = (src[i + j] - offset[j]) * scale[j] + 0.5f;
+                    dst[i + j] = static_cast<std::uint16_t>(std::min(std::max(q, 0.0f), 65535.0f));
+                }
+            }
+            for(std::size_t j = 0; j < num - i; ++j) {
+                const float q = (src[i + j] - offset[j]) * scale[j] + 0.5f;
+                dst[i + j] = static_cast<std::uint16_t>(std::min(std::max(q, 0.0f), 65535.0f));
+            }
+        }
+
+        inline void bounded_to_floats(const std::uint16_t *src,
+                                      float *dst,
+                                      std::size_t num,
+                                      std::size_t components,
+                                      const float *min,
+                                      const float *max)
+        {
+            float offset[bounded_block_size], step[bounded_block_size];
+            for(std::size_t j = 0; j < bounded_block_size; ++j) {
+                const std::size_t c = j % components;
+                offset[j] = min[c];
+                step[j] = (max[c] - min[c]) / 65535.0f;
+            }
+            std::size_t i = 0;
+            for(; i + bounded_block_size <= num; i += bounded_block_size) {
+                for(std::size_t j = 0; j < bounded_block_size; ++j) {
+                    dst[i + j] = offset[j] + src[i + j] * step[j];
+                }
+            }
+            for(std::size_t j = 0; j < num - i; ++j) {
+                dst[i + j] = offset[j] + src[i + j] * step[j];
+            }
+        }
+
+#pragma mark vertex section
+        /* section:
+         *   std::uint32_t count
+         *   std::uint8_t  quantization
+         *   std::uint8_t  components (1 - 4)
+         *   std::uint16_t reserved
+         *   BoundedInt16: float min[components], max[components]
+         *   values (padded to 4 bytes)
+         */
+        static constexpr std::size_t vertex_section_header_size = sizeof(std::uint32_t) * 2;
+
+        inline std::size_t vertex_section_size(std::size_t count,
+                                               std::size_t components,
+                                               Quantization quantization)
+        {
+            const std::size_t num = count * components;
+            switch(quantization) {
+                case Quantization::Half:
+                    return vertex_section_header_size + (num * sizeof(std::uint16_t) + 3) / 4 * 4;
+                case Quantization::BoundedInt16:
+                    return vertex_section_header_size + sizeof(float) * components * 2 + (num * sizeof(std::uint16_t) + 3) / 4 * 4;
+                default:
+                    return vertex_section_header_size + num * sizeof(float);
+            }
+        }
+
+        // return written size
+        inline std::size_t write_vertex_section(char *dst,
+                                                const float *values,
+                                                std::size_t count,
+                                                std::size_t components,
+                                                Quantization quantization)
+        {
+            const std::uint32_t header[2] = {
+                static_cast<std::uint32_t>(count),
+                static_cast<std::uint32_t>(quantization) | static_cast<std::uint32_t>(components << 8)
+            };
+            std::memcpy(dst, header, sizeof(header));
+            char *p = dst + sizeof(header);
+            const std::size_t num = count * components;
+            const std::size_t size = vertex_section_size(count, components, quantization);
+            switch(quantization) {
+                case Quantization::Half:
+                    floats_to_halfs(values, reinterpret_cast<std::uint16_t *>(p), num);
+                    break;
+                case Quantization::BoundedInt16: {
+                    float min[4], max[4];
+                    for(std::size_t c = 0; c < components; ++c) {
+                        min[c] = count ? values[c] : 0.0f;
+                        max[c] = count ? values[c] : 0.0f;
+                    }
+                    for(std::size_t i = 0; i < num; ++i) {
+                        const std::size_t c = i % components;
+                        min[c] = std::min(min[c], values[i]);
+                        max[c] = std::max(max[c], values[i]);
+                    }
+                    std::memcpy(p, min, sizeof(float) * components);
+                    p += sizeof(float) * components;
+                    std::memcpy(p, max, sizeof(float) * components);
+                    p += sizeof(float) * components;
+                    floats_to_bounded(values, reinterpret_cast<std::uint16_t *>(p), num, components, min, max);
+                    break;
+                }
+                default:
+                    std::memcpy(p, values, num * sizeof(float));
+                    break;
+            }
+            // clear padding
+            const std::size_t written = static_cast<std::size_t>(p - dst) + num * (quantization == Quantization::None ? sizeof(float) : sizeof(std::uint16_t));
+            std::memset(dst + written, 0, size - written);
+            return size;
+        }
+
+        // read section count / components. return false if broken
+        inline bool peek_vertex_section(const char *src,
+                                        std::size_t available,
+                                        std::size_t &count,
+                                        std::size_t &components,
+                                        Quantization &quantization)
+        {
+            std::uint32_t header[2];
+            if(available < sizeof(header)) return false;
+            std::memcpy(header, src, sizeof(header));
+            count = header[0];
+            quantization = static_cast<Quantization>(header[1] & 0xFF);
+            components = (header[1] >> 8) & 0xFF;
+            if(components < 1 || 4 < components) return false;
+            if(Quantization::BoundedInt16 < quantization) return false;
+            return vertex_section_size(count, components, quantization) <= available;
+        }
+
+        // values has count * components floats. return read size, 0 if broken
+        inline std::size_t read_vertex_section(const char *src,
+                                               std::size_t available,
+                                               float *values)
+        {
+            std::size_t count, components;
+            Quantization quantization;
+            if(!peek_vertex_section(src, available, count, components, quantization)) return 0;
+            const char *p = src + vertex_section_header_size;
+            const std::size_t num = count * components;
+            switch(quantization) {
+                case Quantization::Half:
+                    halfs_to_floats(reinterpret_cast<const std::uint16_t *>(p), values, num);
+                    break;
+                case Quantization::BoundedInt16: {
+                    float min[4], max[4];
+                    std::memcpy(min, p, sizeof(float) * components);
+                    p += sizeof(float) * components;
+                    std::memcpy(max, p, sizeof(float) * components);
+                    p += sizeof(float) * components;
+                    bounded_to_floats(reinterpret_cast<const std::uint16_t *>(p), values, num, components, min, max);
+                    break;
+                }
+                default:
+                    std::memcpy(values, p, num * sizeof(float));
+                    break;
+            }
+            return vertex_section_size(count, components, quantization);
+        }
+    }; // detail
+}; // ofxZeroMQ
+
+#endif /* ofxZeroMQVertexCodec_h */
@@ -18,6 +18,9 @@
 #include <set>
 #include <tuple>
 #include <thread>
+#include <atomic>
+#include <functional>
+#include <memory>
 
 #include <zmq.hpp>
 #include <zmq_addon.hpp>
@@ -25,6 +28,7 @@
 #include "ofConstants.h"
 #include "ofFileUtils.h"
 #include "ofJson.h"
+#include "ofParameter.h"
 
 #include "ofLog.h"
 
@@ -166,7 +170,7 @@ namespace ofxZeroMQ {
         }
         
         inline Message(zmq::message_t &&mom)
-        { mom.move(*this); };
+        { move(mom); };
         
         inline Message(Message &&v) = default;
 
@@ -360,7 +364,8 @@ namespace ofxZeroMQ {
         inline static void to_zmq_message(ofxZeroMQ::Message &m,
                                           zmq::message_t &&data)
         {
-            m = std::move(data);
+            // zmq::message_t::move moves argument into this
+            m.move(data);
         };
 
         
@@ -655,6 +660,232 @@ namespace ofxZeroMQ {
     };
 };
 
+#pragma mark - SocketMetrics
+
+namespace ofxZeroMQ {
+    // snapshot of Socket::getMetrics()
+    struct SocketMetrics {
+        std::uint64_t sent_messages{0};
+        std::uint64_t sent_bytes{0};
+        std::uint64_t received_messages{0};
+        std::uint64_t received_bytes{0};
+        
+        // EAGAIN on send. i.e. send queue reached high water mark (or no peer for some socket types).
+        // NOTE: PUB/XPUB drop messages silently inside libzmq when HWM is reached, these drops can't be counted.
+        std::uint64_t send_would_block{0};
+        // EAGAIN on receive. i.e. polled but there is no message.
+        std::uint64_t receive_would_block{0};
+        
+        // current queue state from ZMQ_EVENTS
+        bool has_pending_input{false};
+        bool can_send{true};
+    };
+    
+    namespace detail {
+        struct socket_counters {
+            void on_send(bool succeeded, std::size_t bytes) {
+                if(succeeded) {
+                    sent_messages.fetch_add(1, std::memory_order_relaxed);
+                    sent_bytes.fetch_add(bytes, std::memory_order_relaxed);
+                } else {
+                    send_would_block.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            
+            void on_receive(bool succeeded, std::size_t bytes) {
+                if(succeeded) {
+                    received_messages.fetch_add(1, std::memory_order_relaxed);
+                    received_bytes.fetch_add(bytes, std::memory_order_relaxed);
+                } else {
+                    receive_would_block.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            
+            void load(SocketMetrics &metrics) const {
+                metrics.sent_messages = sent_messages.load(std::memory_order_relaxed);
+                metrics.sent_bytes = sent_bytes.load(std::memory_order_relaxed);
+                metrics.received_messages = received_messages.load(std::memory_order_relaxed);
+                metrics.received_bytes = received_bytes.load(std::memory_order_relaxed);
+                metrics.send_would_block = send_would_block.load(std::memory_order_relaxed);
+                metrics.receive_would_block = receive_would_block.load(std::memory_order_relaxed);
+            }
+            
+            void reset() {
+                sent_messages.store(0, std::memory_order_relaxed);
+                sent_bytes.store(0, std::memory_order_relaxed);
+                received_messages.store(0, std::memory_order_relaxed);
+                received_bytes.store(0, std::memory_order_relaxed);
+                send_would_block.store(0, std::memory_order_relaxed);
+                receive_would_block.store(0, std::memory_order_relaxed);
+            }
+            
+            std::atomic<std::uint64_t> sent_messages{0};
+            std::atomic<std::uint64_t> sent_bytes{0};
+            std::atomic<std::uint64_t> received_messages{0};
+            std::atomic<std::uint64_t> received_bytes{0};
+            std::atomic<std::uint64_t> send_would_block{0};
+            std::atomic<std::uint64_t> receive_would_block{0};
+        };
+        
+        inline std::size_t total_size(const zmq::multipart_t &message) {
+            std::size_t size = 0;
+            for(const auto &m : message) size += m.size();
+            return size;
+        }
+        
+        // zmq::multipart_t::send pops each part before sending, so parts are lost when EAGAIN.
+        // zmq sends multipart message atomically, so only the first part can be rejected.
+        // message is cleared only when sent.
+        inline bool send_multipart(zmq::socket_t &socket,
+                                   zmq::multipart_t &message,
+                                   zmq::send_flags flags)
+        {
+            if(message.empty()) return true;
+            flags = flags & ~zmq::send_flags::sndmore;
+            const std::size_t num = message.size();
+            for(std::size_t i = 0; i < num; ++i) {
+                auto part_flags = flags | (i + 1 < num ? zmq::send_flags::sndmore : zmq::send_flags::none);
+                if(!socket.send(message.at(i), part_flags)) {
+                    if(i == 0) return false;
+                    ofLogError("ofxZeroMQ") << "failed to send part " << i << " of multipart message";
+                    break;
+                }
+            }
+            message.clear();
+            return true;
+        }
+    }; // detail
+}; // ofxZeroMQ
+
+#include "detail/ofxZeroMQTracing.h"
+#include "detail/ofxZeroMQRateLimit.h"
+#include "detail/ofxZeroMQTopicTrie.h"
+
+namespace ofxZeroMQ {
+    namespace detail {
+        // hooks called by Socket on each send / receive
+        struct socket_state {
+            void on_send(zmq::multipart_t &message)
+            { if(tracer) tracer->onSend(message); };
+
+            void on_sent(bool sent, std::size_t bytes)
+            { counters.on_send(sent, bytes); };
+
+            void on_received(zmq::multipart_t &message, bool received) {
+                counters.on_receive(received, total_size(message));
+                if(received && tracer) tracer->onReceive(message);
+            }
+
+            void on_received(const zmq::message_t &m, bool received) {
+                counters.on_receive(received, m.size());
+                if(received && tracer && !m.more()) tracer->onReply();
+            }
+
+            // return true if this frame has to be dropped by rate limiter.
+            // decided by first frame, and following frames of same message share the decision
+            bool is_rate_limited(const zmq::message_t &frame, bool more) {
+                if(!limiter) return false;
+                if(!is_continuing) is_dropping = !limiter->acquire(frame.data(), frame.size());
+                is_continuing = more;
+                return is_dropping;
+            }
+
+            socket_counters counters;
+            std::unique_ptr<LatencyTracer> tracer;
+            std::unique_ptr<topic_rate_limiter> limiter;
+            std::unique_ptr<topic_decimator> decimator;
+            bool is_continuing{false};
+            bool is_dropping{false};
+        };
+    }; // detail
+}; // ofxZeroMQ
+
+#pragma mark - awaitable operations
+
+#include "detail/ofxZeroMQReactor.h"
+
+#if OFX_ZEROMQ_HAS_COROUTINE
+namespace ofxZeroMQ {
+    template <typename type>
+    struct ReceiveOperation : detail::awaitable_operation {
+        ReceiveOperation(Reactor &reactor,
+                         zmq::socket_t &socket,
+                         detail::socket_state &state,
+                         type &data)
+        : detail::awaitable_operation(reactor, socket, ZMQ_POLLIN)
+        , state(state)
+        , data(data)
+        {};
+        
+        bool tryComplete() override {
+            bool received = socket->recv(m, zmq::recv_flags::dontwait).has_value();
+            if(received) state.on_received(m, true);
+            return received;
+        }
+        
+        // return true if has more flag
+        bool await_resume() {
+            adl_converter<type>::from_zmq_message(m, data);
+            return m.more();
+        }
+        
+    private:
+        detail::socket_state &state;
+        type &data;
+        Message m;
+    };
+    
+    template <>
+    struct ReceiveOperation<MultipartMessage> : detail::awaitable_operation {
+        ReceiveOperation(Reactor &reactor,
+                         zmq::socket_t &socket,
+                         detail::socket_state &state,
+                         MultipartMessage &message)
+        : detail::awaitable_operation(reactor, socket, ZMQ_POLLIN)
+        , state(state)
+        , message(message)
+        {};
+        
+        bool tryComplete() override {
+            bool received = message.recv(*socket, ZMQ_DONTWAIT);
+            if(received) state.on_received(message, true);
+            return received;
+        }
+        
+        bool await_resume()
+        { return true; };
+        
+    private:
+        detail::socket_state &state;
+        MultipartMessage &message;
+    };
+    
+    struct SendOperation : detail::awaitable_operation {
+        SendOperation(Reactor &reactor,
+                      zmq::socket_t &socket,
+                      detail::socket_state &state,
+                      MultipartMessage &&message)
+        : detail::awaitable_operation(reactor, socket, ZMQ_POLLOUT)
+        , state(state)
+        , message(std::move(message))
+        { state.on_send(this->message); };
+        
+        bool tryComplete() override {
+            std::size_t bytes = detail::total_size(message);
+            bool sent = detail::send_multipart(*socket, message, zmq::send_flags::dontwait);
+            if(sent) state.on_sent(true, bytes);
+            return sent;
+        }
+        
+        void await_resume() {};
+        
+    private:
+        detail::socket_state &state;
+        MultipartMessage message;
+    };
+};
+#endif
+
 #pragma mark - Socket and other implementations
 
 namespace ofxZeroMQ {
@@ -709,10 +940,27 @@ namespace ofxZeroMQ {
             return v;
         }
         
+        SocketMetrics getMetrics() {
+            SocketMetrics metrics;
+            state.counters.load(metrics);
+            std::int32_t events{0};
+            std::size_t size = sizeof(events);
+            socket.getsockopt(ZMQ_EVENTS, &events, &size);
+            metrics.has_pending_input = events & ZMQ_POLLIN;
+            metrics.can_send = events & ZMQ_POLLOUT;
+            return metrics;
+        }
+        void resetMetrics()
+        { state.counters.reset(); };
+        
         zmq::socket_t &getRawSocket()
         { return socket; };
         const zmq::socket_t &getRawSocket() const
         { return socket; };
+        
+        // context shared by all sockets of this addon. inproc endpoints work only in this context.
+        static zmq::context_t &getContext()
+        { return get_context(); };
     protected:
         Socket(int type)
         : socket(get_context(), type)
@@ -737,8 +985,7 @@ namespace ofxZeroMQ {
                                 bool nonblocking = true,
                                 bool more = false)
         {
-            return socket.send(std::move(Message{data, length}),
-                               zmq::send_flags(SendFlag{nonblocking, more}));
+            return send_message(Message{data, length}, SendFlag{nonblocking, more});
         }
         
         template <
@@ -749,15 +996,14 @@ namespace ofxZeroMQ {
                                 bool nonblocking = true,
                                 bool more = false)
         {
-            return socket.send(std::move(Message{data}),
-                               zmq::send_flags(SendFlag{nonblocking, more}));
+            return send_message(Message{data}, SendFlag{nonblocking, more});
         };
                 
         zmq::send_result_t send(MultipartMessage &mess,
                                 bool nonblocking = true,
                                 bool more = false)
         {
-            return mess.send(socket, SendFlag{nonblocking, more});
+            return send_multipart(mess, SendFlag{nonblocking, more});
         };
         
         template <typename ... types>
@@ -767,7 +1013,8 @@ namespace ofxZeroMQ {
                 zmq::send_result_t
             >::type
         {
-            return MultipartMessage{std::forward<types>(data) ...}.send(socket, SendFlag{});
+            MultipartMessage message{std::forward<types>(data) ...};
+            return send_multipart(message, SendFlag{});
         }
 
         template <typename ... types>
@@ -778,14 +1025,15 @@ namespace ofxZeroMQ {
             >::type
         {
             auto flag = std::get<sizeof...(types) - 1>(std::forward_as_tuple(std::forward<types>(data) ...));
-            return MultipartMessage{std::forward<types>(data) ...}.send(socket, flag);
+            MultipartMessage message{std::forward<types>(data) ...};
+            return send_multipart(message, flag);
         }
         
         template <typename type>
         bool receive(type &data, ReceiveFlag flags = ReceiveFlag{})
         {
             Message m;
-            auto &&result = receive(m);
+            auto &&result = receive(m, flags);
             if(result.first.has_value()) {
                 adl_converter<type>::from_zmq_message(m, data);
             }
@@ -794,11 +1042,11 @@ namespace ofxZeroMQ {
         
         bool receive(MultipartMessage &message,
                      ReceiveFlag flags = ReceiveFlag{})
-        { return message.recv(socket, flags); };
+        { return receive_multipart(message, flags); };
         
         bool receiveMultipart(MultipartMessage &message,
                               ReceiveFlag flags = ReceiveFlag{})
-        { return message.recv(socket, flags); };
+        { return receive_multipart(message, flags); };
 
         template <typename ... types>
         auto receiveMultipart(types & ... data)
@@ -842,19 +1090,124 @@ namespace ofxZeroMQ {
             return 0;
         }
         
+#if OFX_ZEROMQ_HAS_COROUTINE
+        // co_await-able versions of receive / send. completed by Reactor::poll
+        template <typename type>
+        ReceiveOperation<type> asyncReceive(Reactor &reactor, type &data)
+        { return { reactor, socket, state, data }; };
+        
+        ReceiveOperation<MultipartMessage> asyncReceiveMultipart(Reactor &reactor,
+                                                                 MultipartMessage &message)
+        { return { reactor, socket, state, message }; };
+        
+        // message is owned by operation until sent, so lvalue has to be passed by std::move
+        SendOperation asyncSend(Reactor &reactor, MultipartMessage &&message)
+        { return { reactor, socket, state, std::move(message) }; };
+        
+        template <
+            typename type,
+            typename = typename std::enable_if<
+                !std::is_same<typename std::decay<type>::type, MultipartMessage>::value
+            >::type
+        >
+        SendOperation asyncSend(Reactor &reactor, type &&data) {
+            MultipartMessage message;
+            message.addArgument(std::forward<type>(data));
+            return { reactor, socket, state, std::move(message) };
+        }
+        
+        template <typename ... types>
+        SendOperation asyncSendMultipart(Reactor &reactor, types && ... data)
+        { return { reactor, socket, state, MultipartMessage{std::forward<types>(data) ...} }; };
+#endif
+        
         zmq::socket_t socket;
         zmq::pollitem_t item;
     protected:
-        std::pair<zmq::recv_result_t, bool> receive(Message &m) {
-            std::int32_t more;
-            std::size_t more_size{sizeof(more)};
-            
-            zmq::recv_flags flags;
-            
+        std::pair<zmq::recv_result_t, bool> receive(Message &m,
+                                                    ReceiveFlag flags = ReceiveFlag{})
+        {
             auto &&res = socket.recv(m, flags);
+            state.on_received(m, res.has_value());
             return {res, m.more()};
         }
         
+        zmq::send_result_t send_message(Message &&m, SendFlag flag) {
+            if(state.is_rate_limited(m, flag.more)) return {};
+            if(state.tracer && !flag.more) {
+                // trace frame has to be appended as last part. limiter is already checked
+                MultipartMessage message;
+                message.add(std::move(m));
+                return send_multipart_unlimited(message, flag);
+            }
+            const std::size_t length = m.size();
+            auto &&result = socket.send(m, zmq::send_flags(flag));
+            state.on_sent(result.has_value(), length);
+            return result;
+        }
+        
+        zmq::send_result_t send_multipart(MultipartMessage &message, SendFlag flag) {
+            if(!message.empty() && state.is_rate_limited(message.front(), false)) {
+                message.clear();
+                return {};
+            }
+            return send_multipart_unlimited(message, flag);
+        }
+        
+        // rate limiter has to be checked once per message by caller
+        zmq::send_result_t send_multipart_unlimited(MultipartMessage &message, SendFlag flag) {
+            const std::size_t num_parts = message.size();
+            state.on_send(message);
+            const std::size_t bytes = detail::total_size(message);
+            bool sent = detail::send_multipart(socket, message, flag);
+            state.on_sent(sent, bytes);
+            if(!sent) {
+                // message is given back to caller for retry, so trace frame appended by on_send is removed
+                while(num_parts < message.size()) message.remove();
+                return {};
+            }
+            return bytes;
+        }
+        
+        bool receive_multipart(MultipartMessage &message, ReceiveFlag flags) {
+            if(state.decimator) return receive_decimated(message, flags);
+            bool received = message.recv(socket, flags);
+            state.on_received(message, received);
+            return received;
+        }
+        
+        // drain queued messages into decimator before converting any of them,
+        // so dropped messages cost only receiving.
+        // draining stops when some message passes, so the rest stays in socket and RCVHWM still applies
+        bool receive_decimated(MultipartMessage &message, ReceiveFlag flags) {
+            auto &decimator = *state.decimator;
+            while(!decimator.hasReady() && message.recv(socket, ZMQ_DONTWAIT)) {
+                state.on_received(message, true);
+                decimator.offer(message);
+            }
+            decimator.release();
+            if(decimator.pop(message)) return true;
+            if(flags.nonblocking) {
+                state.on_received(message, false);
+                return false;
+            }
+            // blocking receive waits until some message passes
+            while(message.recv(socket, flags)) {
+                state.on_received(message, true);
+                decimator.offer(message);
+                decimator.release();
+                if(decimator.pop(message)) return true;
+            }
+            return false;
+        }
+        
+        void set_tracing_enabled(bool enabled, LatencyTracer::Mode mode) {
+            if(!enabled) state.tracer.reset();
+            else if(!state.tracer) state.tracer.reset(new LatencyTracer(mode));
+        }
+        
+        detail::socket_state state;
+        
     private:
         static zmq::context_t &get_context() {
             static zmq::context_t context{4};
@@ -862,6 +1215,56 @@ namespace ofxZeroMQ {
         }
     };
     
+#pragma mark -
+    // expose SocketMetrics as ofParameterGroup. call update() periodically (e.g. in ofApp::update)
+    struct SocketMetricsParameters {
+        void setup(const std::string &name, Socket &socket) {
+            this->socket = &socket;
+            group.setName(name);
+            group.add(sent_messages.set("sent messages", 0));
+            group.add(sent_bytes.set("sent bytes", 0));
+            group.add(received_messages.set("received messages", 0));
+            group.add(received_bytes.set("received bytes", 0));
+            group.add(send_would_block.set("send would block", 0));
+            group.add(receive_would_block.set("receive would block", 0));
+            group.add(has_pending_input.set("has pending input", false));
+            group.add(can_send.set("can send", true));
+        }
+        
+        void update() {
+            if(socket == nullptr) return;
+            const SocketMetrics metrics = socket->getMetrics();
+            sent_messages = metrics.sent_messages;
+            sent_bytes = metrics.sent_bytes;
+            received_messages = metrics.received_messages;
+            received_bytes = metrics.received_bytes;
+            send_would_block = metrics.send_would_block;
+            receive_would_block = metrics.receive_would_block;
+            has_pending_input = metrics.has_pending_input;
+            can_send = metrics.can_send;
+        }
+        
+        ofParameterGroup &getParameters()
+        { return group; };
+        const ofParameterGroup &getParameters() const
+        { return group; };
+        
+        operator ofParameterGroup &()
+        { return group; };
+        
+    protected:
+        Socket *socket{nullptr};
+        ofParameterGroup group;
+        ofParameter<std::uint64_t> sent_messages;
+        ofParameter<std::uint64_t> sent_bytes;
+        ofParameter<std::uint64_t> received_messages;
+        ofParameter<std::uint64_t> received_bytes;
+        ofParameter<std::uint64_t> send_would_block;
+        ofParameter<std::uint64_t> receive_would_block;
+        ofParameter<bool> has_pending_input;
+        ofParameter<bool> can_send;
+    };
+    
 #pragma mark -
     struct Publisher : Socket {
         Publisher()
@@ -877,10 +1280,38 @@ namespace ofxZeroMQ {
         
         using Socket::send;
         using Socket::sendMultipart;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncSend;
+        using Socket::asyncSendMultipart;
+#endif
+        
+        // append timestamp frame as last part of each message. receiver needs Subscriber::setTracingEnabled(true)
+        void setTracingEnabled(bool enabled)
+        { set_tracing_enabled(enabled, LatencyTracer::Mode::Stamp); };
+        bool isTracingEnabled() const
+        { return static_cast<bool>(state.tracer); };
+        
+        // token bucket per topic prefix (first frame). messages over the rate are dropped before being sent,
+        // and send returns no value for them. longest matching prefix is used.
+        // burst is number of messages which can be sent at once after idle time.
+        void setRateLimit(const std::string &prefix, float messages_per_second, float burst = 1.0f) {
+            if(!state.limiter) state.limiter.reset(new detail::topic_rate_limiter());
+            state.limiter->set(prefix, messages_per_second, burst);
+        }
+        // return false if rate limit of given prefix is not set
+        bool removeRateLimit(const std::string &prefix) {
+            if(!state.limiter || !state.limiter->remove(prefix)) return false;
+            if(state.limiter->empty() && !state.is_continuing) state.limiter.reset();
+            return true;
+        }
+        std::uint64_t getNumRateLimited() const
+        { return state.limiter ? state.limiter->num_dropped : 0; };
     };
     
 #pragma mark -
     struct Subscriber : Socket {
+        using Handler = std::function<void(MultipartMessage &message)>;
+        
         Subscriber()
         : Socket(ZMQ_SUB)
         {};
@@ -890,9 +1321,33 @@ namespace ofxZeroMQ {
         using Socket::receive;
         using Socket::receiveMultipart;
         
-        using Socket::hasWaitingMessage;
         using Socket::getNextMessage;
         using Socket::getNextMessages;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncReceive;
+        using Socket::asyncReceiveMultipart;
+#endif
+
+        // with decimation, true also if decimated messages are ready or held one is released in timeout
+        bool hasWaitingMessage(long timeout_millis = 0) {
+            if(!state.decimator) return Socket::hasWaitingMessage(timeout_millis);
+            auto &decimator = *state.decimator;
+            decimator.release();
+            if(!decimator.hasReady()) {
+                const auto release = decimator.getTimeToRelease();
+                long wait = timeout_millis;
+                if(release != detail::topic_decimator::clock::duration::max()) {
+                    const long release_millis = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(release).count()) + 1;
+                    wait = timeout_millis < 0 ? release_millis : std::min(timeout_millis, release_millis);
+                }
+                if(Socket::hasWaitingMessage(wait)) return true;
+                decimator.release();
+                if(!decimator.hasReady()) return false;
+            }
+            // getNextMessage checks revents of last poll
+            item.revents |= ZMQ_POLLIN;
+            return true;
+        }
 
         void connect(const std::string &address) {
             if(filters.empty()) addFilter("");
@@ -902,10 +1357,16 @@ namespace ofxZeroMQ {
             filters.insert(filter);
             socket.setsockopt(ZMQ_SUBSCRIBE, filter.data(), filter.size());
         }
-        // return false if give filter string is not subscribed
+        // subscribe filter and call handler with messages whose topic (first frame) starts with filter in dispatch()
+        void addFilter(const std::string &filter, Handler handler) {
+            if(filters.find(filter) == filters.end()) addFilter(filter);
+            handlers.insert(filter, std::make_shared<Handler>(std::move(handler)));
+        }
+        // return false if give filter string is not subscribed. handler of filter is removed too
         bool removeFilter(const std::string &filter) {
             if(0 < filters.erase(filter)) {
                 socket.setsockopt(ZMQ_UNSUBSCRIBE, filter.data(), filter.size());
+                handlers.erase(filter);
                 return true;
             }
             return false;
@@ -913,9 +1374,80 @@ namespace ofxZeroMQ {
         void removeAllFilters() {
             for(const auto &v : filters) socket.setsockopt(ZMQ_UNSUBSCRIBE, v.data(), v.size());
             filters.clear();
+            handlers.clear();
         }
+        
+        // called with messages which match no handler
+        void setDefaultHandler(Handler handler)
+        { default_handler = std::move(handler); };
+        
+        // receive waiting messages and call handlers of all filters which are prefix of topic, from shortest.
+        // lookup is O(topic length) regardless of number of handlers. return number of received messages.
+        // handlers of a message are collected before calling them, so handlers can add / remove filters.
+        // such changes are applied from next message. dispatch can't be called from handler
+        std::size_t dispatch() {
+            if(is_dispatching) {
+                ofLogWarning("ofxZeroMQSubscriber::dispatch") << "dispatch is called from handler. ignored";
+                return 0;
+            }
+            is_dispatching = true;
+            std::size_t num = 0;
+            MultipartMessage message;
+            while(receiveMultipart(message)) {
+                ++num;
+                // reused, so no allocation after first messages. shared_ptr keeps removed handler alive while calling it
+                matched_handlers.clear();
+                if(!message.empty()) {
+                    handlers.match(message.front().data(), message.front().size(), [this](std::shared_ptr<Handler> &handler) {
+                        matched_handlers.push_back(handler);
+                    });
+                }
+                for(auto &handler : matched_handlers) if(*handler) (*handler)(message);
+                if(matched_handlers.empty() && default_handler) default_handler(message);
+            }
+            matched_handlers.clear();
+            is_dispatching = false;
+            return num;
+        }
+        
+        // strip timestamp frame appended by traced Publisher and record latency per topic (first frame).
+        // trace frame is stripped only on multipart receive (receiveMultipart, getNextMessage(MultipartMessage &), etc.)
+        void setTracingEnabled(bool enabled)
+        { set_tracing_enabled(enabled, LatencyTracer::Mode::Record); };
+        bool isTracingEnabled() const
+        { return static_cast<bool>(state.tracer); };
+        
+        // nullptr if tracing is disabled
+        const LatencyTracer *getLatencyTracer() const
+        { return state.tracer.get(); };
+        LatencyTracer *getLatencyTracer()
+        { return state.tracer.get(); };
+        
+        // keep every Nth message of each topic (first frame) which starts with prefix. longest matching prefix is used.
+        // decimation works only on multipart receive. queued messages are drained on each receive until one passes,
+        // and dropped messages are never converted.
+        void setDecimation(const std::string &prefix, std::uint32_t every_n)
+        { get_decimator().setEveryN(prefix, every_n); };
+        // keep only latest message of each topic (first frame) under prefix in each interval.
+        // held message is released by receive or hasWaitingMessage after interval
+        void setDecimationInterval(const std::string &prefix, float seconds)
+        { get_decimator().setInterval(prefix, seconds); };
+        // return false if decimation of given prefix is not set. held message is still received
+        bool removeDecimation(const std::string &prefix)
+        { return state.decimator && state.decimator->remove(prefix); };
+        std::uint64_t getNumDecimated() const
+        { return state.decimator ? state.decimator->num_dropped : 0; };
     private:
+        detail::topic_decimator &get_decimator() {
+            if(!state.decimator) state.decimator.reset(new detail::topic_decimator());
+            return *state.decimator;
+        }
+        
         std::set<std::string> filters;
+        detail::topic_trie<std::shared_ptr<Handler>> handlers;
+        std::vector<std::shared_ptr<Handler>> matched_handlers;
+        Handler default_handler;
+        bool is_dispatching{false};
     };
     
 #pragma mark -
@@ -936,6 +1468,24 @@ namespace ofxZeroMQ {
         using Socket::hasWaitingMessage;
         using Socket::getNextMessage;
         using Socket::getNextMessages;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncSend;
+        using Socket::asyncSendMultipart;
+        using Socket::asyncReceive;
+        using Socket::asyncReceiveMultipart;
+#endif
+        
+        // record round trip time of each request locally. no frame is added.
+        void setTracingEnabled(bool enabled)
+        { set_tracing_enabled(enabled, LatencyTracer::Mode::RoundTrip); };
+        bool isTracingEnabled() const
+        { return static_cast<bool>(state.tracer); };
+        
+        // nullptr if tracing is disabled
+        const LatencyTracer *getLatencyTracer() const
+        { return state.tracer.get(); };
+        LatencyTracer *getLatencyTracer()
+        { return state.tracer.get(); };
     };
     
 #pragma mark -
@@ -956,6 +1506,12 @@ namespace ofxZeroMQ {
         using Socket::hasWaitingMessage;
         using Socket::getNextMessage;
         using Socket::getNextMessages;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncSend;
+        using Socket::asyncSendMultipart;
+        using Socket::asyncReceive;
+        using Socket::asyncReceiveMultipart;
+#endif
     };
     
 #pragma mark -
@@ -979,6 +1535,12 @@ namespace ofxZeroMQ {
         using Socket::hasWaitingMessage;
         using Socket::getNextMessage;
         using Socket::getNextMessages;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncSend;
+        using Socket::asyncSendMultipart;
+        using Socket::asyncReceive;
+        using Socket::asyncReceiveMultipart;
+#endif
     };
     
 #pragma mark -
@@ -1002,6 +1564,12 @@ namespace ofxZeroMQ {
         using Socket::hasWaitingMessage;
         using Socket::getNextMessage;
         using Socket::getNextMessages;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncSend;
+        using Socket::asyncSendMultipart;
+        using Socket::asyncReceive;
+        using Socket::asyncReceiveMultipart;
+#endif
     };
 
 #pragma mark -
@@ -1025,6 +1593,12 @@ namespace ofxZeroMQ {
         using Socket::hasWaitingMessage;
         using Socket::getNextMessage;
         using Socket::getNextMessages;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncSend;
+        using Socket::asyncSendMultipart;
+        using Socket::asyncReceive;
+        using Socket::asyncReceiveMultipart;
+#endif
     };
     
 #pragma mark -
@@ -1040,6 +1614,10 @@ namespace ofxZeroMQ {
         using Socket::receiveMultipart;
         
         using Socket::hasWaitingMessage;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncSendMultipart;
+        using Socket::asyncReceiveMultipart;
+#endif
     };
     
 #pragma mark -
@@ -1051,10 +1629,17 @@ namespace ofxZeroMQ {
         using Socket::bind;
         using Socket::unbind;
         
+        using Socket::connect;
+        using Socket::disconnect;
+        
         using Socket::sendMultipart;
         using Socket::receiveMultipart;
 
         using Socket::hasWaitingMessage;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncSendMultipart;
+        using Socket::asyncReceiveMultipart;
+#endif
     };
     
 #pragma mark -
@@ -1068,6 +1653,15 @@ namespace ofxZeroMQ {
 
         using Socket::send;
         using Socket::sendMultipart;
+        
+        // subscription notifications: [1 (subscribe) or 0 (unsubscribe)][filter ...]
+        using Socket::receive;
+        using Socket::receiveMultipart;
+        using Socket::hasWaitingMessage;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncSend;
+        using Socket::asyncSendMultipart;
+#endif
     };
     
 #pragma mark -
@@ -1085,6 +1679,10 @@ namespace ofxZeroMQ {
         using Socket::hasWaitingMessage;
         using Socket::getNextMessage;
         using Socket::getNextMessages;
+#if OFX_ZEROMQ_HAS_COROUTINE
+        using Socket::asyncReceive;
+        using Socket::asyncReceiveMultipart;
+#endif
     };
     
 #pragma mark -
@@ -1109,10 +1707,12 @@ namespace ofxZeroMQ {
                     MultipartMessage m;
                     while(router.hasWaitingMessage()) {
                         router.receiveMultipart(m);
+                        if(is_tracing) detail::add_trace_hop(m);
                         dealer.sendMultipart(std::move(m));
                     }
                     while(dealer.hasWaitingMessage()) {
                         dealer.receiveMultipart(m);
+                        if(is_tracing) detail::add_trace_hop(m);
                         router.sendMultipart(std::move(m));
                     }
                     std::this_thread::sleep_for(std::chrono::milliseconds(1));
@@ -1121,10 +1721,15 @@ namespace ofxZeroMQ {
             }).detach();
         }
         
+        // add hop timestamp to messages traced by Publisher::setTracingEnabled
+        void setTracingEnabled(bool enabled)
+        { is_tracing = enabled; };
+        
         Router router;
         Dealer dealer;
         std::atomic_bool is_running;
         std::atomic_bool is_finish;
+        std::atomic_bool is_tracing{false};
     };
 
 #pragma mark -
@@ -1149,6 +1754,7 @@ namespace ofxZeroMQ {
                     MultipartMessage m;
                     while(sub.hasWaitingMessage()) {
                         sub.receiveMultipart(m);
+                        if(is_tracing) detail::add_trace_hop(m);
                         pub.sendMultipart(std::move(m));
                     }
                     std::this_thread::sleep_for(std::chrono::milliseconds(1));
@@ -1166,18 +1772,27 @@ namespace ofxZeroMQ {
         { return sub; };
         const XSubscriber &getXSubscriber() const
         { return sub; };
+        
+        // add hop timestamp to messages traced by Publisher::setTracingEnabled
+        void setTracingEnabled(bool enabled)
+        { is_tracing = enabled; };
 
     protected:
         XPublisher pub;
         XSubscriber sub;
         std::atomic_bool is_running;
         std::atomic_bool is_finish;
+        std::atomic_bool is_tracing{false};
     };
 };
 
 using ofxZeroMQMessage = ofxZeroMQ::Message;
 using ofxZeroMQMultipartMessage = ofxZeroMQ::MultipartMessage;
 using ofxZeroMQSocket = ofxZeroMQ::Socket;
+using ofxZeroMQSocketMetrics = ofxZeroMQ::SocketMetrics;
+using ofxZeroMQSocketMetricsParameters = ofxZeroMQ::SocketMetricsParameters;
+using ofxZeroMQLatencyHistogram = ofxZeroMQ::LatencyHistogram;
+using ofxZeroMQLatencyTracer = ofxZeroMQ::LatencyTracer;
 
 using ofxZeroMQPublisher = ofxZeroMQ::Publisher;
 using ofxZeroMQSubscriber = ofxZeroMQ::Subscriber;
@@ -1185,6 +1800,9 @@ using ofxZeroMQSubscriber = ofxZeroMQ::Subscriber;
 using ofxZeroMQRequest = ofxZeroMQ::Request;
 using ofxZeroMQReply = ofxZeroMQ::Reply;
 
+using ofxZeroMQPush = ofxZeroMQ::Push;
+using ofxZeroMQPull = ofxZeroMQ::Pull;
+
 using ofxZeroMQPair = ofxZeroMQ::Pair;
 
 using ofxZeroMQRouter = ofxZeroMQ::Router;
@@ -1195,4 +1813,29 @@ using ofxZeroMQXPublisher = ofxZeroMQ::XPublisher;
 using ofxZeroMQXSubscriber = ofxZeroMQ::XSubscriber;
 using ofxZeroMQXPubSubProxy = ofxZeroMQ::XPubSubProxy;
 
+#if OFX_ZEROMQ_HAS_COROUTINE
+using ofxZeroMQReactor = ofxZeroMQ::Reactor;
+#endif
+
+#pragma mark - components
+
+#include "ofxZeroMQSocketMonitor.h"
+#include "ofxZeroMQPriorityLanes.h"
+#include "ofxZeroMQStreamTransfer.h"
+#include "ofxZeroMQBatch.h"
+#include "ofxZeroMQSpool.h"
+#include "ofxZeroMQCapture.h"
+#include "ofxZeroMQSharding.h"
+#include "ofxZeroMQImageEncoder.h"
+#include "ofxZeroMQPixelsDelta.h"
+#include "ofxZeroMQAudio.h"
+#include "ofxZeroMQClusterSync.h"
+#include "ofxZeroMQClone.h"
+#include "ofxZeroMQParameterSync.h"
+#include "ofxZeroMQServiceBroker.h"
+#include "ofxZeroMQPipeline.h"
+#include "ofxZeroMQReliableRequest.h"
+#include "ofxZeroMQContentFilter.h"
+#include "ofxZeroMQSyncedStart.h"
+
 #endif /* ofxZeroMQ_h */
@@ -0,0 +1,335 @@
+//
+//  ofxZeroMQAudio.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQAudio_h
+#define ofxZeroMQAudio_h
+
+#include "ofxZeroMQ.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cmath>
+
+#include "ofSoundBuffer.h"
+
+// usage:
+//
+// // sender
+// ofxZeroMQAudioSender sender;
+// sender.bind("tcp://*:26666");
+// void audioIn(ofSoundBuffer &buffer) { sender.send(buffer); } // small buffer size (64 - 256 frames) for low latency
+//
+// // receiver
+// ofxZeroMQAudioReceiver receiver;
+// receiver.setTargetLatency(5.0f); // milliseconds
+// receiver.setup("tcp://sender:26666");
+// void audioOut(ofSoundBuffer &buffer) { receiver.fill(buffer); }
+
+namespace ofxZeroMQ {
+#pragma mark - AudioSender
+    // message: [topic][std::uint64_t sequence][std::uint64_t sample clock][ofSoundBuffer]
+    // call send only from one thread (usually audio thread).
+    struct AudioSender {
+        AudioSender(const std::string &topic = "audio")
+        : topic(topic)
+        {
+            // stale audio is useless. keep queue short
+            publisher.setSendHighWaterMark(16);
+        }
+
+        void bind(const std::string &address)
+        { publisher.bind(address); };
+        void unbind(const std::string &address)
+        { publisher.unbind(address); };
+        void connect(const std::string &address)
+        { publisher.connect(address); };
+        void disconnect(const std::string &address)
+        { publisher.disconnect(address); };
+
+        bool send(const ofSoundBuffer &buffer) {
+            const std::uint64_t clock = sample_clock;
+            sample_clock += buffer.getNumFrames();
+            return publisher.sendMultipart(topic, sequence++, clock, buffer).has_value();
+        }
+
+        Publisher &getPublisher()
+        { return publisher; };
+
+    protected:
+        Publisher publisher;
+        std::string topic;
+        std::uint64_t sequence{0};
+        std::uint64_t sample_clock{0};
+    };
+
+#pragma mark - AudioReceiver
+    // receives on own thread into jitter buffer, and fill is called from audioOut.
+    // buffer level is kept around target latency + 3 * measured jitter:
+    // drift between sender / receiver sample clocks is absorbed by dropping / repeating one frame per callback,
+    // lost blocks are filled with silence, and playback restarts after priming when underrun.
+    struct AudioReceiver {
+        AudioReceiver() {};
+        AudioReceiver(const AudioReceiver &) = delete;
+        AudioReceiver &operator=(const AudioReceiver &) = delete;
+
+        virtual ~AudioReceiver()
+        { close(); };
+
+        bool setup(const std::string &address, const std::string &topic = "audio") {
+            close();
+            subscriber.setReceiveHighWaterMark(16);
+            subscriber.addFilter(topic);
+            subscriber.connect(address);
+            this->address = address;
+            is_running = true;
+            thread = std::thread([this] { process(); });
+            return true;
+        }
+
+        void close() {
+            if(!is_running) return;
+            is_running = false;
+            if(thread.joinable()) thread.join();
+            subscriber.disconnect(address);
+            std::lock_guard<std::mutex> lock(mutex);
+            reset();
+        }
+
+        void setTargetLatency(float milliseconds)
+        { target_latency_millis = std::max(0.0f, milliseconds); };
+        float getTargetLatency() const
+        { return target_latency_millis; };
+        // buffer is cleared down to target latency if exceeded
+        void setMaxLatency(float milliseconds)
+        { max_latency_millis = std::max(1.0f, milliseconds); };
+
+        // call from audioOut
+        void fill(ofSoundBuffer &output) {
+            const std::size_t out_frames = output.getNumFrames();
+            const std::size_t out_channels = output.getNumChannels();
+            auto &out = output.getBuffer();
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if(num_channels == 0 || sample_rate == 0) {
+                std::fill(out.begin(), out.end(), 0.0f);
+                return;
+            }
+            if(output.getSampleRate() != sample_rate && !is_sample_rate_warned) {
+                ofLogWarning("ofxZeroMQAudioReceiver") << "sample rate mismatch. stream: " << sample_rate << ", output: " << output.getSampleRate();
+                is_sample_rate_warned = true;
+            }
+
+            const std::size_t target = target_frames();
+            if(is_priming) {
+                if(level < target + out_frames) {
+                    std::fill(out.begin(), out.end(), 0.0f);
+                    return;
+                }
+                is_priming = false;
+            }
+
+            const std::size_t max_frames = millis_to_frames(max_latency_millis);
+            if(max_frames < level && target + out_frames < level) {
+                const std::size_t skip = level - target - out_frames;
+                advance(skip);
+                num_dropped_frames += skip;
+            } else if(target + target / 2 + out_frames < level) {
+                // sender clock is faster
+                advance(1);
+                ++num_dropped_frames;
+            }
+
+            if(level < out_frames) {
+                const std::size_t available = level;
+                read(out.data(), available, out_channels);
+                std::fill(out.begin() + available * out_channels, out.end(), 0.0f);
+                is_priming = true;
+                ++num_underruns;
+                return;
+            }
+
+            if(level < target / 2 + out_frames && 1 < out_frames) {
+                // sender clock is slower. stretch by repeating last frame
+                read(out.data(), out_frames - 1, out_channels);
+                std::copy(out.end() - 2 * out_channels, out.end() - out_channels, out.end() - out_channels);
+                ++num_repeated_frames;
+                return;
+            }
+            read(out.data(), out_frames, out_channels);
+        }
+
+        // buffered audio in milliseconds
+        float getLatency() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return sample_rate ? 1000.0f * level / sample_rate : 0.0f;
+        }
+        // RFC 3550 interarrival jitter in milliseconds
+        float getJitter() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return static_cast<float>(jitter_nanos / 1000000.0);
+        }
+        std::uint64_t getNumUnderruns() const
+        { return num_underruns; };
+        std::uint64_t getNumLostFrames() const
+        { return num_lost_frames; };
+        std::uint64_t getNumDroppedFrames() const
+        { return num_dropped_frames; };
+        std::uint64_t getNumRepeatedFrames() const
+        { return num_repeated_frames; };
+
+    protected:
+        void process() {
+            MultipartMessage m;
+            ofSoundBuffer buffer;
+            while(is_running) {
+                if(!subscriber.hasWaitingMessage(10)) continue;
+                while(subscriber.receiveMultipart(m)) {
+                    if(m.size() < 4) continue;
+                    const auto sequence = m[1].get<std::uint64_t>();
+                    const auto clock = m[2].get<std::uint64_t>();
+                    m[3].to(buffer);
+                    push(sequence, clock, buffer);
+                }
+            }
+        }
+
+        void push(std::uint64_t sequence, std::uint64_t clock, const ofSoundBuffer &buffer) {
+            const std::int64_t arrival = detail::now_nanos();
+            std::lock_guard<std::mutex> lock(mutex);
+            if(buffer.getNumChannels() != num_channels || buffer.getSampleRate() != sample_rate) {
+                num_channels = buffer.getNumChannels();
+                sample_rate = buffer.getSampleRate();
+                reset();
+                ring.assign(millis_to_frames(max_latency_millis) * 2 * num_channels + buffer.size(), 0.0f);
+            }
+            // sequence jumped back far beyond reordering. sender is restarted
+            if(is_receiving && sequence + restart_threshold < next_sequence) {
+                ofLogNotice("ofxZeroMQAudioReceiver") << "sender restarted. reset";
+                reset();
+            }
+            if(is_receiving) {
+                if(clock < next_clock || sequence < next_sequence) return; // late or duplicated
+                const std::uint64_t gap = clock - next_clock;
+                if(ring_frames() < gap) {
+                    reset();
+                } else if(0 < gap) {
+                    write_silence(static_cast<std::size_t>(gap));
+                    num_lost_frames += gap;
+                }
+                // jitter of transit time (arrival - media time)
+                const std::int64_t transit = arrival - static_cast<std::int64_t>(clock * 1000000000.0 / sample_rate);
+                const double d = std::abs(static_cast<double>(transit - last_transit));
+                jitter_nanos += (d - jitter_nanos) / 16.0;
+                last_transit = transit;
+            } else {
+                last_transit = arrival - static_cast<std::int64_t>(clock * 1000000000.0 / sample_rate);
+                is_receiving = true;
+            }
+            write(buffer.getBuffer().data(), buffer.getNumFrames());
+            next_clock = clock + buffer.getNumFrames();
+            next_sequence = sequence + 1;
+        }
+
+        std::size_t millis_to_frames(double millis) const
+        { return static_cast<std::size_t>(millis * sample_rate / 1000.0); };
+        std::size_t target_frames() const
+        { return std::min(millis_to_frames(target_latency_millis + 3.0 * jitter_nanos / 1000000.0), millis_to_frames(max_latency_millis)); };
+        std::size_t ring_frames() const
+        { return num_channels ? ring.size() / num_channels : 0; };
+
+        void write(const float *samples, std::size_t frames) {
+            const std::size_t capacity = ring_frames();
+            for(std::size_t i = 0; i < frames; ++i) {
+                std::copy(samples + i * num_channels, samples + (i + 1) * num_channels, ring.begin() + write_pos * num_channels);
+                write_pos = (write_pos + 1) % capacity;
+            }
+            commit(frames);
+        }
+
+        void write_silence(std::size_t frames) {
+            const std::size_t capacity = ring_frames();
+            for(std::size_t i = 0; i < frames; ++i) {
+                std::fill(ring.begin() + write_pos * num_channels, ring.begin() + (write_pos + 1) * num_channels, 0.0f);
+                write_pos = (write_pos + 1) % capacity;
+            }
+            commit(frames);
+        }
+
+        void commit(std::size_t frames) {
+            level += frames;
+            const std::size_t capacity = ring_frames();
+            if(capacity < level) {
+                // overflow. oldest frames are overwritten
+                num_dropped_frames += level - capacity;
+                read_pos = write_pos;
+                level = capacity;
+            }
+        }
+
+        void advance(std::size_t frames) {
+            frames = std::min(frames, level);
+            read_pos = (read_pos + frames) % ring_frames();
+            level -= frames;
+        }
+
+        // mono stream is copied to all output channels. extra output channels are silent
+        void read(float *out, std::size_t frames, std::size_t out_channels) {
+            const std::size_t capacity = ring_frames();
+            for(std::size_t i = 0; i < frames; ++i) {
+                const float *frame = ring.data() + read_pos * num_channels;
+                for(std::size_t c = 0; c < out_channels; ++c) {
+                    out[i * out_channels + c] = c < num_channels ? frame[c] : (num_channels == 1 ? frame[0] : 0.0f);
+                }
+                read_pos = (read_pos + 1) % capacity;
+            }
+            level -= frames;
+        }
+
+        void reset() {
+            read_pos = write_pos = level = 0;
+            is_priming = true;
+            is_receiving = false;
+            jitter_nanos = 0.0;
+        }
+
+        static constexpr std::uint64_t restart_threshold = 64;
+
+        Subscriber subscriber;
+        std::string address;
+        std::thread thread;
+        std::atomic_bool is_running{false};
+
+        mutable std::mutex mutex;
+        std::vector<float> ring;
+        std::size_t read_pos{0};
+        std::size_t write_pos{0};
+        std::size_t level{0};
+        std::size_t num_channels{0};
+        std::size_t sample_rate{0};
+        bool is_priming{true};
+        bool is_receiving{false};
+        bool is_sample_rate_warned{false};
+        std::uint64_t next_sequence{0};
+        std::uint64_t next_clock{0};
+        std::int64_t last_transit{0};
+        double jitter_nanos{0.0};
+
+        float target_latency_millis{5.0f};
+        float max_latency_millis{50.0f};
+
+        std::atomic<std::uint64_t> num_underruns{0};
+        std::atomic<std::uint64_t> num_lost_frames{0};
+        std::atomic<std::uint64_t> num_dropped_frames{0};
+        std::atomic<std::uint64_t> num_repeated_frames{0};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQAudioSender = ofxZeroMQ::AudioSender;
+using ofxZeroMQAudioReceiver = ofxZeroMQ::AudioReceiver;
+
+#endif /* ofxZeroMQAudio_h */
@@ -0,0 +1,236 @@
+//
+//  ofxZeroMQBatch.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQBatch_h
+#define ofxZeroMQBatch_h
+
+#include "ofxZeroMQ.h"
+
+#include <chrono>
+#include <iterator>
+
+// usage:
+//
+// // sender
+// ofxZeroMQPublisher pub;
+// ofxZeroMQBatchSender<ofxZeroMQPublisher> batcher{pub, "sensor"};
+// batcher.add(glm::vec3{x, y, z}); // sent when 64KB are packed or 200us passed since first add
+// batcher.update(); // flush expired batch. call frequently (e.g. sender thread loop) for tight latency bound
+//
+// // receiver
+// ofxZeroMQMultipartMessage m;
+// sub.receiveMultipart(m);
+// for(auto &&item : ofxZeroMQBatchView{m.at(1)}) {
+//     glm::vec3 v = item;
+// }
+
+namespace ofxZeroMQ {
+    namespace detail {
+        // each item is packed as [std::uint32_t length][bytes]
+        using batch_length_type = std::uint32_t;
+    }; // detail
+
+#pragma mark - BatchSender
+    template <typename socket_type>
+    struct BatchSender {
+        // if topic is not empty, batch is sent as [topic, batch frame], otherwise [batch frame]
+        BatchSender(socket_type &socket,
+                    const std::string &topic = "",
+                    std::size_t max_bytes = 64 * 1024,
+                    std::chrono::microseconds max_delay = std::chrono::microseconds(200))
+        : socket(socket)
+        , topic(topic)
+        , max_bytes(max_bytes)
+        , max_delay(max_delay)
+        { buffer.reserve(max_bytes); };
+
+        // socket has to outlive this
+        ~BatchSender()
+        { if(!flush()) drop(); };
+
+        void setMaxBytes(std::size_t bytes)
+        { max_bytes = bytes; };
+        void setMaxDelay(std::chrono::microseconds delay)
+        { max_delay = delay; };
+
+        // value is converted by to_zmq_message as same as Message
+        template <typename type>
+        void add(type &&value) {
+            Message m{std::forward<type>(value)};
+            addRaw(m.data(), m.size());
+        }
+
+        void addRaw(const void *data, std::size_t size) {
+            // batch which can't be sent yet is dropped here, so buffer doesn't grow beyond max_bytes
+            if(!buffer.empty() && max_bytes < buffer.size() + sizeof(detail::batch_length_type) + size && !flush()) drop();
+            if(buffer.empty()) first_added_time = std::chrono::steady_clock::now();
+
+            const detail::batch_length_type length = static_cast<detail::batch_length_type>(size);
+            const std::size_t offset = buffer.size();
+            buffer.resize(offset + sizeof(length) + size);
+            std::memcpy(buffer.data() + offset, &length, sizeof(length));
+            std::memcpy(buffer.data() + offset + sizeof(length), data, size);
+            ++num_items;
+
+            if(max_bytes <= buffer.size()) flush();
+            else update();
+        }
+
+        // flush if max_delay is passed since first item of current batch
+        void update() {
+            if(!buffer.empty() && max_delay <= std::chrono::steady_clock::now() - first_added_time) flush();
+        }
+
+        // return false if batch couldn't be sent (e.g. HWM is reached).
+        // batch is kept, and sent again by next flush / update / add
+        bool flush() {
+            if(buffer.empty()) return true;
+            MultipartMessage message;
+            if(!topic.empty()) message.addArgument(topic);
+            message.add(Message{buffer.data(), buffer.size()});
+            if(!socket.send(message)) return false;
+            buffer.clear();
+            num_items = 0;
+            return true;
+        }
+
+        std::size_t getNumPendingItems() const
+        { return num_items; };
+        std::size_t getNumPendingBytes() const
+        { return buffer.size(); };
+        // items of batches dropped because they couldn't be sent before next batch is full
+        std::uint64_t getNumDroppedItems() const
+        { return num_dropped_items; };
+
+    protected:
+        void drop() {
+            if(buffer.empty()) return;
+            ofLogWarning("ofxZeroMQBatchSender") << "failed to send batch. " << num_items << " items are dropped";
+            num_dropped_items += num_items;
+            buffer.clear();
+            num_items = 0;
+        }
+
+        socket_type &socket;
+        std::string topic;
+        std::size_t max_bytes;
+        std::chrono::microseconds max_delay;
+        std::vector<char> buffer;
+        std::size_t num_items{0};
+        std::uint64_t num_dropped_items{0};
+        std::chrono::steady_clock::time_point first_added_time;
+    };
+
+#pragma mark - BatchView
+    // iterates items packed by BatchSender without copy.
+    // the viewed message must outlive the view.
+    struct BatchView {
+        struct Item {
+            const void *data() const
+            { return ptr; };
+            std::size_t size() const
+            { return length; };
+
+            // message without free function references bytes of item (zmq_msg_init_data),
+            // so item is converted without copy nor allocation
+            template <typename type>
+            void to(type &value) const {
+                const Message m{const_cast<char *>(ptr), length, nullptr, nullptr};
+                adl_converter<type>::from_zmq_message(m, value);
+            }
+
+            template <typename type>
+            type get() const {
+                type value;
+                to(value);
+                return value;
+            }
+
+            template <typename type>
+            operator type() const
+            { return get<type>(); };
+
+            const char *ptr;
+            std::size_t length;
+        };
+
+        struct iterator {
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Item;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Item *;
+            using reference = const Item &;
+
+            iterator(const char *cursor, const char *end)
+            : cursor(cursor)
+            , end(end)
+            { read(); };
+
+            reference operator*() const
+            { return item; };
+            pointer operator->() const
+            { return &item; };
+
+            iterator &operator++() {
+                cursor = item.ptr + item.length;
+                read();
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator it = *this;
+                ++(*this);
+                return it;
+            }
+
+            bool operator==(const iterator &rhs) const
+            { return cursor == rhs.cursor; };
+            bool operator!=(const iterator &rhs) const
+            { return cursor != rhs.cursor; };
+
+        private:
+            void read() {
+                detail::batch_length_type length;
+                const std::size_t remaining = static_cast<std::size_t>(end - cursor);
+                if(remaining < sizeof(length)) {
+                    cursor = end;
+                    return;
+                }
+                std::memcpy(&length, cursor, sizeof(length));
+                if(remaining - sizeof(length) < length) {
+                    ofLogWarning("ofxZeroMQBatchView") << "broken batch frame";
+                    cursor = end;
+                    return;
+                }
+                item.ptr = cursor + sizeof(length);
+                item.length = length;
+            }
+
+            const char *cursor;
+            const char *end;
+            Item item{nullptr, 0};
+        };
+
+        BatchView(const zmq::message_t &message)
+        : first(static_cast<const char *>(message.data()))
+        , last(static_cast<const char *>(message.data()) + message.size())
+        {};
+
+        iterator begin() const
+        { return { first, last }; };
+        iterator end() const
+        { return { last, last }; };
+
+    private:
+        const char *first;
+        const char *last;
+    };
+}; // ofxZeroMQ
+
+template <typename socket_type>
+using ofxZeroMQBatchSender = ofxZeroMQ::BatchSender<socket_type>;
+using ofxZeroMQBatchView = ofxZeroMQ::BatchView;
+
+#endif /* ofxZeroMQBatch_h */
@@ -0,0 +1,376 @@
+//
+//  ofxZeroMQCapture.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQCapture_h
+#define ofxZeroMQCapture_h
+
+#include "ofxZeroMQ.h"
+#include "detail/ofxZeroMQMappedFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "ofFileUtils.h"
+
+// usage:
+//
+// // record
+// ofxZeroMQCaptureRecorder recorder;
+// recorder.open("traffic.zcap"); // relative to data path
+// ofxZeroMQMultipartMessage m;
+// while(recorder.receiveMultipart(sub, m)) { ... } // received and recorded with receive time
+// recorder.close(); // write index
+//
+// // replay
+// ofxZeroMQPublisher pub;
+// pub.bind("tcp://*:26666");
+// ofxZeroMQCaptureReplayer replayer{pub};
+// replayer.open("traffic.zcap");
+// replayer.setSpeed(2.0); // 1.0: real-time, 0.0: as fast as possible
+// replayer.play();
+// replayer.update(); // call every frame. or replayer.run() blocks until end with precise timing
+
+namespace ofxZeroMQ {
+    namespace detail {
+        /* capture file:
+         * header
+         *   std::uint64_t magic
+         *   std::uint64_t data_end
+         *   std::uint64_t num_records
+         *   std::uint64_t index_offset // 0 if not closed properly
+         *   std::int64_t  start_time   // unix time in nanoseconds
+         *   std::uint64_t reserved[3]
+         * records
+         *   std::int64_t  time // nanoseconds from start_time
+         *   std::uint32_t num_parts
+         *   { std::uint32_t size, bytes[size] } * num_parts
+         * index
+         *   std::uint64_t offset * num_records
+         */
+        static constexpr std::uint64_t capture_magic = 0x72747061637A666FULL; // "ofzcaptr"
+        static constexpr std::size_t capture_header_size = sizeof(std::uint64_t) * 8;
+
+        namespace capture_header {
+            static constexpr std::size_t magic = 0;
+            static constexpr std::size_t data_end = 8;
+            static constexpr std::size_t num_records = 16;
+            static constexpr std::size_t index_offset = 24;
+            static constexpr std::size_t start_time = 32;
+        }; // capture_header
+
+        static constexpr std::size_t capture_record_header_size = sizeof(std::int64_t) + sizeof(std::uint32_t);
+
+        // return size of record at p, 0 if record is broken (runs over available bytes)
+        inline std::uint64_t capture_record_size(const char *p, std::uint64_t available) {
+            std::uint64_t size = capture_record_header_size;
+            if(available < size) return 0;
+            const std::uint32_t num_parts = read_u32(p + sizeof(std::int64_t));
+            for(std::uint32_t i = 0; i < num_parts; ++i) {
+                if(available - size < sizeof(std::uint32_t)) return 0;
+                const std::uint32_t part_size = read_u32(p + size);
+                size += sizeof(std::uint32_t);
+                if(available - size < part_size) return 0;
+                size += part_size;
+            }
+            return size;
+        }
+    }; // detail
+
+#pragma mark - CaptureRecorder
+    struct CaptureRecorder {
+        CaptureRecorder() {};
+        CaptureRecorder(const CaptureRecorder &) = delete;
+        CaptureRecorder &operator=(const CaptureRecorder &) = delete;
+
+        ~CaptureRecorder()
+        { close(); };
+
+        // existing file is overwritten. file grows by doubling from reserve_size
+        bool open(const std::string &path,
+                  std::size_t reserve_size = 64 * 1024 * 1024)
+        {
+            close();
+            if(!file.open(ofToDataPath(path, true), std::max(reserve_size, detail::capture_header_size))) return false;
+            std::memset(file.data(), 0, detail::capture_header_size);
+            detail::write_u64(file.data() + detail::capture_header::magic, detail::capture_magic);
+            detail::write_u64(file.data() + detail::capture_header::data_end, detail::capture_header_size);
+            const auto now = std::chrono::system_clock::now().time_since_epoch();
+            detail::write_u64(file.data() + detail::capture_header::start_time,
+                              static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+            data_end = detail::capture_header_size;
+            start_nanos = detail::now_nanos();
+            offsets.clear();
+            return true;
+        }
+
+        // record message with current time
+        bool record(const zmq::multipart_t &message)
+        { return record(message, detail::now_nanos() - start_nanos); };
+
+        bool record(const zmq::multipart_t &message, std::int64_t time_nanos) {
+            if(!file.isOpen()) return false;
+            std::size_t record_size = sizeof(std::int64_t) + sizeof(std::uint32_t);
+            for(const auto &part : message) record_size += sizeof(std::uint32_t) + part.size();
+            if(file.size() < data_end + record_size
+               && !file.resize(std::max(file.size() * 2, data_end + record_size)))
+            {
+                return false;
+            }
+
+            char *p = file.data() + data_end;
+            detail::write_u64(p, static_cast<std::uint64_t>(time_nanos));
+            p += sizeof(std::int64_t);
+            detail::write_u32(p, static_cast<std::uint32_t>(message.size()));
+            p += sizeof(std::uint32_t);
+            for(const auto &part : message) {
+                detail::write_u32(p, static_cast<std::uint32_t>(part.size()));
+                p += sizeof(std::uint32_t);
+                std::memcpy(p, part.data(), part.size());
+                p += part.size();
+            }
+
+            offsets.push_back(data_end);
+            data_end += record_size;
+            detail::write_u64(file.data() + detail::capture_header::data_end, data_end);
+            detail::write_u64(file.data() + detail::capture_header::num_records, offsets.size());
+            return true;
+        }
+
+        // receive from socket and record it
+        template <typename socket_type>
+        bool receiveMultipart(socket_type &socket, MultipartMessage &message) {
+            if(!socket.receiveMultipart(message)) return false;
+            record(message);
+            return true;
+        }
+
+        // write index and truncate file to actual size
+        void close() {
+            if(!file.isOpen()) return;
+            const std::size_t index_size = offsets.size() * sizeof(std::uint64_t);
+            if(file.resize(data_end + index_size)) {
+                for(std::size_t i = 0; i < offsets.size(); ++i) {
+                    detail::write_u64(file.data() + data_end + i * sizeof(std::uint64_t), offsets[i]);
+                }
+                detail::write_u64(file.data() + detail::capture_header::index_offset, data_end);
+                file.flush();
+            }
+            file.close();
+            offsets.clear();
+        }
+
+        bool isOpen() const
+        { return file.isOpen(); };
+        std::size_t getNumRecords() const
+        { return offsets.size(); };
+        std::uint64_t getNumBytes() const
+        { return data_end; };
+
+    protected:
+        detail::mapped_file file;
+        std::vector<std::uint64_t> offsets;
+        std::uint64_t data_end{0};
+        std::int64_t start_nanos{0};
+    };
+
+#pragma mark - CaptureReader
+    struct CaptureReader {
+        // index is rebuilt by scanning records if file was not closed properly
+        bool open(const std::string &path) {
+            close();
+            const std::string resolved = ofToDataPath(path, true);
+            if(!ofFile::doesFileExist(resolved, false)) {
+                ofLogError("ofxZeroMQCaptureReader") << "file not found: " << resolved;
+                return false;
+            }
+            // read only, so archived / shipped files can be replayed
+            if(!file.openReadOnly(resolved)) return false;
+            if(file.size() < detail::capture_header_size
+               || detail::read_u64(file.data() + detail::capture_header::magic) != detail::capture_magic)
+            {
+                ofLogError("ofxZeroMQCaptureReader") << "not a capture file: " << path;
+                file.close();
+                return false;
+            }
+            data_end = std::min<std::uint64_t>(detail::read_u64(file.data() + detail::capture_header::data_end), file.size());
+            const std::uint64_t num_records = detail::read_u64(file.data() + detail::capture_header::num_records);
+            const std::uint64_t index_offset = detail::read_u64(file.data() + detail::capture_header::index_offset);
+            offsets.clear();
+            if(index_offset != 0
+               && index_offset <= file.size()
+               && num_records <= (file.size() - index_offset) / sizeof(std::uint64_t))
+            {
+                offsets.resize(static_cast<std::size_t>(num_records));
+                for(std::size_t i = 0; i < offsets.size(); ++i) {
+                    offsets[i] = detail::read_u64(file.data() + index_offset + i * sizeof(std::uint64_t));
+                    if(!is_valid_offset(offsets[i])) {
+                        ofLogWarning("ofxZeroMQCaptureReader") << "index is broken: " << path;
+                        offsets.clear();
+                        break;
+                    }
+                }
+            }
+            if(offsets.empty() && detail::capture_header_size < data_end) {
+                ofLogWarning("ofxZeroMQCaptureReader") << "index is missing. scan records: " << path;
+                for(std::uint64_t pos = detail::capture_header_size; pos < data_end; ) {
+                    const std::uint64_t record_size = detail::capture_record_size(file.data() + pos, data_end - pos);
+                    if(record_size == 0) {
+                        ofLogWarning("ofxZeroMQCaptureReader") << "broken record at " << pos << ". following records are ignored";
+                        break;
+                    }
+                    offsets.push_back(pos);
+                    pos += record_size;
+                }
+            }
+            return true;
+        }
+
+        void close() {
+            file.close();
+            offsets.clear();
+            data_end = 0;
+        }
+
+        bool isOpen() const
+        { return file.isOpen(); };
+        std::size_t size() const
+        { return offsets.size(); };
+
+        // unix time in nanoseconds when recording started
+        std::int64_t getStartTime() const
+        { return static_cast<std::int64_t>(detail::read_u64(file.data() + detail::capture_header::start_time)); };
+        // nanoseconds from start of recording
+        std::int64_t getTime(std::size_t index) const
+        { return static_cast<std::int64_t>(detail::read_u64(file.data() + offsets[index])); };
+        std::int64_t getDuration() const
+        { return offsets.empty() ? 0 : getTime(offsets.size() - 1) - getTime(0); };
+
+        bool read(std::size_t index, MultipartMessage &message) const {
+            message.clear();
+            if(offsets.size() <= index) return false;
+            if(detail::capture_record_size(file.data() + offsets[index], data_end - offsets[index]) == 0) {
+                ofLogWarning("ofxZeroMQCaptureReader") << "broken record " << index;
+                return false;
+            }
+            const char *p = file.data() + offsets[index] + sizeof(std::int64_t);
+            const std::uint32_t num_parts = detail::read_u32(p);
+            p += sizeof(std::uint32_t);
+            for(std::uint32_t i = 0; i < num_parts; ++i) {
+                const std::uint32_t size = detail::read_u32(p);
+                p += sizeof(std::uint32_t);
+                message.addmem(p, size);
+                p += size;
+            }
+            return true;
+        }
+
+    protected:
+        // record header of offset is in data
+        bool is_valid_offset(std::uint64_t offset) const
+        { return detail::capture_header_size <= offset && offset <= data_end && detail::capture_record_header_size <= data_end - offset; };
+
+        detail::mapped_file file;
+        std::vector<std::uint64_t> offsets;
+        std::uint64_t data_end{0};
+    };
+
+#pragma mark - CaptureReplayer
+    template <typename socket_type>
+    struct CaptureReplayer {
+        CaptureReplayer(socket_type &socket)
+        : socket(socket)
+        {};
+
+        bool open(const std::string &path) {
+            stop();
+            return reader.open(path);
+        }
+
+        // 1.0 is real-time. 0.0 sends as fast as possible
+        void setSpeed(double speed) {
+            this->speed = 0.0 < speed ? speed : 0.0;
+            // keep current position
+            if(is_playing) play(next_index);
+        }
+        double getSpeed() const
+        { return speed; };
+
+        void setLoop(bool loop)
+        { is_loop = loop; };
+
+        void play(std::size_t from_index = 0) {
+            next_index = from_index;
+            is_playing = next_index < reader.size();
+            if(!is_playing) return;
+            play_started = std::chrono::steady_clock::now();
+            base_time = reader.getTime(next_index);
+        }
+        void stop()
+        { is_playing = false; };
+        bool isPlaying() const
+        { return is_playing; };
+
+        // send all messages which are due. return number of sent messages
+        std::size_t update() {
+            std::size_t num_sent = 0;
+            const auto now = std::chrono::steady_clock::now();
+            while(is_playing && scheduled_time(next_index) <= now) {
+                send_next();
+                ++num_sent;
+            }
+            return num_sent;
+        }
+
+        // replay to the end on this thread with sleeping until each message is due
+        void run() {
+            if(!is_playing) play(next_index);
+            bool loop = is_loop;
+            is_loop = false;
+            while(is_playing) {
+                if(0.0 < speed) std::this_thread::sleep_until(scheduled_time(next_index));
+                send_next();
+            }
+            is_loop = loop;
+        }
+
+        std::size_t getPosition() const
+        { return next_index; };
+        CaptureReader &getReader()
+        { return reader; };
+
+    protected:
+        std::chrono::steady_clock::time_point scheduled_time(std::size_t index) const {
+            if(speed == 0.0) return play_started;
+            const double elapsed = static_cast<double>(reader.getTime(index) - base_time) / speed;
+            return play_started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::nano>(elapsed));
+        }
+
+        void send_next() {
+            MultipartMessage message;
+            if(reader.read(next_index, message)) socket.send(message);
+            ++next_index;
+            if(next_index < reader.size()) return;
+            if(is_loop) play(0);
+            else is_playing = false;
+        }
+
+        socket_type &socket;
+        CaptureReader reader;
+        double speed{1.0};
+        bool is_loop{false};
+        bool is_playing{false};
+        std::size_t next_index{0};
+        std::chrono::steady_clock::time_point play_started;
+        std::int64_t base_time{0};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQCaptureRecorder = ofxZeroMQ::CaptureRecorder;
+using ofxZeroMQCaptureReader = ofxZeroMQ::CaptureReader;
+using ofxZeroMQCaptureReplayer = ofxZeroMQ::CaptureReplayer<ofxZeroMQ::Publisher>;
+
+#endif /* ofxZeroMQCapture_h */
@@ -0,0 +1,312 @@
+//
+//  ofxZeroMQClone.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQClone_h
+#define ofxZeroMQClone_h
+
+#include "ofxZeroMQ.h"
+#include "ofxZeroMQPriorityLanes.h"
+
+#include <chrono>
+#include <map>
+
+#include "ofEvents.h"
+
+// usage:
+//
+// // server (owner of state)
+// ofxZeroMQCloneServer server;
+// server.bind("tcp://*:26666"); // snapshot uses 26667
+// server.set("scene/light/intensity", 0.8f); // published only if value is changed
+// server.update(); // every frame. answers snapshots, applies sets from clients
+//
+// // client
+// ofxZeroMQCloneClient client;
+// client.setup("tcp://server:26666"); // or setup(address, "scene/light/") for subtree
+// client.update(); // every frame
+// float intensity = client.get<float>("scene/light/intensity");
+// client.set("scene/light/intensity", 0.5f); // forwarded to server, and applied when it comes back as delta
+//
+// keys have to be non-empty, and keys beginning with '$' are reserved.
+
+namespace ofxZeroMQ {
+    namespace detail {
+        /* delta (PUB):         [key][std::uint64_t sequence][value], erase has no value part
+         * heartbeat (PUB):     [$heartbeat][std::uint64_t sequence]
+         * snapshot (DEALER):   [snapshot][subtree]
+         *       -> (ROUTER):   [std::uint64_t sequence]{[key][value]} * num entries
+         * set (DEALER):        [set][key][value]
+         * erase (DEALER):      [erase][key]
+         */
+        static constexpr const char *clone_heartbeat_key = "$heartbeat";
+        static constexpr const char *clone_snapshot_command = "snapshot";
+        static constexpr const char *clone_set_command = "set";
+        static constexpr const char *clone_erase_command = "erase";
+
+        // snapshot uses next port for tcp:// with explicit port, otherwise appends ".snapshot".
+        inline std::string snapshot_endpoint(const std::string &address)
+        { return offset_endpoint(address, 1, ".snapshot"); };
+
+        inline bool is_same_message(const zmq::message_t &a, const zmq::message_t &b) {
+            return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+        }
+
+        // zmq_msg_copy shares buffer of large message instead of copying
+        inline Message share_message(Message &m) {
+            Message shared;
+            shared.copy(m);
+            return shared;
+        }
+
+        struct clone_store {
+            template <typename type>
+            bool get(const std::string &key, type &value) const {
+                auto it = values.find(key);
+                if(it == values.end()) return false;
+                adl_converter<type>::from_zmq_message(it->second, value);
+                return true;
+            }
+
+            template <typename type>
+            type get(const std::string &key) const {
+                type value{};
+                get(key, value);
+                return value;
+            }
+
+            bool has(const std::string &key) const
+            { return values.find(key) != values.end(); };
+            std::size_t size() const
+            { return values.size(); };
+            const std::map<std::string, Message> &getValues() const
+            { return values; };
+
+            std::map<std::string, Message> values;
+        };
+    }; // detail
+
+#pragma mark - CloneServer
+    struct CloneServer : detail::clone_store {
+        void bind(const std::string &address)
+        { bind(address, detail::snapshot_endpoint(address)); };
+        void bind(const std::string &delta_address,
+                  const std::string &snapshot_address)
+        {
+            publisher.bind(delta_address);
+            router.bind(snapshot_address);
+        }
+
+        // idle server publishes current sequence in this interval, so clients detect lost last delta
+        void setHeartbeatInterval(long interval_millis)
+        { heartbeat_interval_millis = interval_millis; };
+
+        // return false if value is same as current one (nothing is published)
+        template <typename type>
+        bool set(const std::string &key, type &&value)
+        { return set_message(key, Message{std::forward<type>(value)}); };
+
+        bool erase(const std::string &key) {
+            if(values.erase(key) == 0) return false;
+            publisher.sendMultipart(key, ++sequence);
+            last_published = std::chrono::steady_clock::now();
+            return true;
+        }
+
+        // answer snapshot requests, apply set / erase from clients, and send heartbeat
+        void update() {
+            MultipartMessage m;
+            while(router.receiveMultipart(m)) {
+                if(m.size() < 3) continue;
+                const std::string command = m[1];
+                const std::string key = m[2];
+                if(command == detail::clone_snapshot_command) {
+                    send_snapshot(m.pop(), key);
+                } else if(command == detail::clone_set_command && 4 <= m.size()) {
+                    if(is_valid_key(key) && set_message(key, std::move(m.at(3)))) notify(key);
+                } else if(command == detail::clone_erase_command) {
+                    if(erase(key)) notify(key);
+                }
+            }
+            const auto now = std::chrono::steady_clock::now();
+            if(0 < heartbeat_interval_millis && std::chrono::milliseconds(heartbeat_interval_millis) <= now - last_published) {
+                publisher.sendMultipart(detail::clone_heartbeat_key, sequence);
+                last_published = now;
+            }
+        }
+
+        std::uint64_t getSequence() const
+        { return sequence; };
+
+        // key changed by client
+        ofEvent<const std::string> valueChanged;
+
+    protected:
+        bool set_message(const std::string &key, Message &&value) {
+            if(!is_valid_key(key)) {
+                ofLogWarning("ofxZeroMQCloneServer") << "invalid key: \"" << key << "\"";
+                return false;
+            }
+            auto it = values.find(key);
+            if(it != values.end()) {
+                if(detail::is_same_message(it->second, value)) return false;
+                it->second.move(value);
+            } else {
+                it = values.emplace(key, std::move(value)).first;
+            }
+            publisher.sendMultipart(key, ++sequence, detail::share_message(it->second));
+            last_published = std::chrono::steady_clock::now();
+            return true;
+        }
+
+        // whole subtree is sent as one multipart message, so it is not dropped partially by ROUTER HWM
+        void send_snapshot(Message &&identity, const std::string &subtree) {
+            MultipartMessage reply;
+            reply.add(std::move(identity));
+            reply.addArgument(sequence);
+            for(auto it = values.lower_bound(subtree); it != values.end() && it->first.compare(0, subtree.size(), subtree) == 0; ++it) {
+                reply.addArgument(it->first);
+                reply.add(detail::share_message(it->second));
+            }
+            router.sendMultipart(std::move(reply));
+        }
+
+        void notify(const std::string &key)
+        { ofNotifyEvent(valueChanged, key, this); };
+
+        static bool is_valid_key(const std::string &key)
+        { return !key.empty() && key[0] != '$'; };
+
+        Publisher publisher;
+        Router router;
+        std::uint64_t sequence{0};
+        long heartbeat_interval_millis{1000};
+        std::chrono::steady_clock::time_point last_published{std::chrono::steady_clock::now()};
+    };
+
+#pragma mark - CloneClient
+    struct CloneClient : detail::clone_store {
+        // only keys starting with subtree are replicated.
+        // gaps of sequence are detected only when subtree is empty, because other deltas are filtered out by SUB.
+        void setup(const std::string &address, const std::string &subtree = "")
+        { setup(address, detail::snapshot_endpoint(address), subtree); };
+        void setup(const std::string &delta_address,
+                   const std::string &snapshot_address,
+                   const std::string &subtree)
+        {
+            this->subtree = subtree;
+            subscriber.addFilter(subtree);
+            if(!subtree.empty()) subscriber.addFilter(detail::clone_heartbeat_key);
+            subscriber.connect(delta_address);
+            dealer.connect(snapshot_address);
+            request_snapshot();
+        }
+
+        // resend snapshot request if no reply in this time
+        void setSnapshotTimeout(long timeout_millis)
+        { snapshot_timeout_millis = timeout_millis; };
+
+        // receive snapshot / deltas. call every frame
+        void update() {
+            if(is_waiting_snapshot) {
+                receive_snapshot();
+                // deltas are queued in SUB until snapshot arrives
+                if(is_waiting_snapshot) return;
+            }
+            MultipartMessage m;
+            while(subscriber.receiveMultipart(m)) {
+                if(m.size() < 2) continue;
+                const std::string key = m[0];
+                const std::uint64_t received_sequence = m[1];
+                if(key == detail::clone_heartbeat_key) {
+                    if(subtree.empty() && sequence < received_sequence) {
+                        resync();
+                        return;
+                    }
+                    continue;
+                }
+                // already in snapshot
+                if(received_sequence <= sequence) continue;
+                if(subtree.empty() && received_sequence != sequence + 1) {
+                    resync();
+                    return;
+                }
+                sequence = received_sequence;
+                if(3 <= m.size()) values[key].move(m.at(2));
+                else values.erase(key);
+                ofNotifyEvent(valueChanged, key, this);
+            }
+        }
+
+        // request to server. value is updated when delta comes back
+        template <typename type>
+        void set(const std::string &key, type &&value)
+        { dealer.sendMultipart(detail::clone_set_command, key, std::forward<type>(value)); };
+        void erase(const std::string &key)
+        { dealer.sendMultipart(detail::clone_erase_command, key); };
+
+        // false until first snapshot, and while resyncing
+        bool isSynced() const
+        { return !is_waiting_snapshot; };
+        std::uint64_t getSequence() const
+        { return sequence; };
+        std::uint64_t getNumResyncs() const
+        { return num_resyncs; };
+
+        // key received by snapshot or delta
+        ofEvent<const std::string> valueChanged;
+        // snapshot is applied
+        ofEvent<const std::uint64_t> synced;
+
+    protected:
+        void request_snapshot() {
+            dealer.sendMultipart(detail::clone_snapshot_command, subtree);
+            snapshot_requested = std::chrono::steady_clock::now();
+            is_waiting_snapshot = true;
+        }
+
+        void resync() {
+            ofLogNotice("ofxZeroMQCloneClient") << "gap after sequence " << sequence << ". resync by snapshot";
+            ++num_resyncs;
+            request_snapshot();
+        }
+
+        void receive_snapshot() {
+            MultipartMessage m;
+            if(!dealer.receiveMultipart(m)) {
+                if(std::chrono::milliseconds(snapshot_timeout_millis) <= std::chrono::steady_clock::now() - snapshot_requested) {
+                    request_snapshot();
+                }
+                return;
+            }
+            if(m.size() < 1) return;
+            sequence = m[0];
+            std::map<std::string, Message> snapshot;
+            for(std::size_t i = 1; i + 1 < m.size(); i += 2) {
+                const std::string key = m[i];
+                snapshot[key].move(m.at(i + 1));
+            }
+            values.swap(snapshot);
+            is_waiting_snapshot = false;
+            for(const auto &value : values) ofNotifyEvent(valueChanged, value.first, this);
+            const std::uint64_t synced_sequence = sequence;
+            ofNotifyEvent(synced, synced_sequence, this);
+        }
+
+        Subscriber subscriber;
+        Dealer dealer;
+        std::string subtree;
+        std::uint64_t sequence{0};
+        bool is_waiting_snapshot{false};
+        long snapshot_timeout_millis{1000};
+        std::chrono::steady_clock::time_point snapshot_requested;
+        std::uint64_t num_resyncs{0};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQCloneServer = ofxZeroMQ::CloneServer;
+using ofxZeroMQCloneClient = ofxZeroMQ::CloneClient;
+
+#endif /* ofxZeroMQClone_h */
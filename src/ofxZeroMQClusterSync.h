@@ -0,0 +1,286 @@
+//
+//  ofxZeroMQClusterSync.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQClusterSync_h
+#define ofxZeroMQClusterSync_h
+
+#include "ofxZeroMQ.h"
+#include "ofxZeroMQPriorityLanes.h"
+
+#include <chrono>
+#include <map>
+
+// usage:
+//
+// // master
+// ofxZeroMQClusterSyncMaster master;
+// master.bind("tcp://*:26666"); // barrier uses 26667
+// master.setNumClients(3);
+//
+// void update() { master.beginFrame(camera_position, scene_time); } // broadcast frame state
+// void draw() {
+//     ... // render
+//     master.waitForSwap(); // release all clients, then swap
+// }
+//
+// // client
+// ofxZeroMQClusterSyncClient client;
+// client.setup("tcp://master:26666", "wall-left");
+//
+// void update() {
+//     if(client.waitForFrame()) {
+//         camera_position = client.getState()[0];
+//         scene_time = client.getState()[1];
+//     }
+// }
+// void draw() {
+//     ... // render
+//     client.waitForSwap(); // blocks until master releases barrier
+// }
+//
+// set ofSetVerticalSync(true) on all machines, and swap barrier makes buffer swaps in same vsync interval.
+
+namespace ofxZeroMQ {
+    namespace detail {
+        // frame: [frame topic][std::uint64_t frame number][state ...], swap: [swap topic][std::uint64_t frame number] on PUB.
+        // ready: [ready command][std::uint64_t frame number], hello: [hello command] on DEALER -> ROUTER.
+        static constexpr const char *cluster_frame_topic = "frame";
+        static constexpr const char *cluster_swap_topic = "swap";
+        static constexpr const char *cluster_ready_command = "ready";
+        static constexpr const char *cluster_hello_command = "hello";
+
+        // barrier uses next port for tcp:// with explicit port, otherwise appends ".barrier".
+        inline std::string barrier_endpoint(const std::string &address)
+        { return offset_endpoint(address, 1, ".barrier"); };
+
+        inline float elapsed_millis(std::chrono::steady_clock::time_point since) {
+            return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - since).count();
+        }
+    }; // detail
+
+#pragma mark - ClusterSyncMaster
+    struct ClusterSyncMaster {
+        ClusterSyncMaster() {
+            // barrier messages should not wait behind large state
+            publisher.setSendHighWaterMark(4);
+        }
+
+        void bind(const std::string &address)
+        { bind(address, detail::barrier_endpoint(address)); };
+        void bind(const std::string &state_address,
+                  const std::string &barrier_address)
+        {
+            publisher.bind(state_address);
+            router.bind(barrier_address);
+        }
+
+        // waitForSwap waits ready from this number of clients.
+        // 0 means clients which have said hello
+        void setNumClients(std::size_t num)
+        { num_clients = num; };
+        // barrier is released after timeout even if some clients are not ready
+        void setTimeout(long timeout_millis)
+        { this->timeout_millis = timeout_millis; };
+        // client missed barrier consecutively this times is removed until next hello / ready
+        void setMaxMissedFrames(std::size_t num)
+        { max_missed_frames = num; };
+
+        // broadcast next frame number with state. state is received by client as MultipartMessage
+        template <typename ... types>
+        bool beginFrame(types && ... state) {
+            process(0);
+            ++frame_number;
+            num_ready = 0;
+            return publisher.sendMultipart(detail::cluster_frame_topic, frame_number, std::forward<types>(state) ...).has_value();
+        }
+
+        // call just before swap buffers. return false if timed out.
+        bool waitForSwap() {
+            const auto begin = std::chrono::steady_clock::now();
+            bool is_completed = true;
+            while(!isAllReady()) {
+                const long remain = timeout_millis - static_cast<long>(detail::elapsed_millis(begin));
+                if(remain <= 0) {
+                    is_completed = false;
+                    break;
+                }
+                process(remain);
+            }
+            publisher.sendMultipart(detail::cluster_swap_topic, frame_number);
+            barrier_latency = detail::elapsed_millis(begin);
+
+            if(!is_completed) {
+                ++num_timeouts;
+                for(auto it = clients.begin(); it != clients.end();) {
+                    if(it->second.ready_frame == frame_number || ++it->second.num_missed < max_missed_frames) {
+                        ++it;
+                        continue;
+                    }
+                    ofLogWarning("ofxZeroMQClusterSyncMaster") << "client " << it->first << " is lost";
+                    it = clients.erase(it);
+                }
+            }
+            return is_completed;
+        }
+
+        bool isAllReady() const {
+            const std::size_t required = num_clients ? num_clients : clients.size();
+            return required <= num_ready;
+        }
+
+        std::uint64_t getFrameNum() const
+        { return frame_number; };
+        std::size_t getNumConnectedClients() const
+        { return clients.size(); };
+        std::vector<std::string> getClientNames() const {
+            std::vector<std::string> names;
+            for(const auto &client : clients) names.push_back(client.first);
+            return names;
+        }
+        // time spent in last waitForSwap
+        float getBarrierLatency() const
+        { return barrier_latency; };
+        std::uint64_t getNumTimeouts() const
+        { return num_timeouts; };
+
+        Publisher &getPublisher()
+        { return publisher; };
+
+    protected:
+        struct Client {
+            std::uint64_t ready_frame{0};
+            std::size_t num_missed{0};
+        };
+
+        // receive hello / ready until timeout, or all clients are ready
+        void process(long timeout_millis) {
+            if(!router.hasWaitingMessage(timeout_millis)) return;
+            MultipartMessage m;
+            while(router.receiveMultipart(m)) {
+                if(m.size() < 2) continue;
+                const std::string name = m[0];
+                const std::string command = m[1];
+                Client &client = clients[name];
+                if(command == detail::cluster_ready_command && 3 <= m.size()) {
+                    const std::uint64_t frame = m[2];
+                    if(frame == frame_number && client.ready_frame != frame_number) {
+                        client.ready_frame = frame;
+                        client.num_missed = 0;
+                        ++num_ready;
+                    }
+                } else if(command == detail::cluster_hello_command) {
+                    ofLogNotice("ofxZeroMQClusterSyncMaster") << "client " << name << " joined";
+                }
+                if(isAllReady()) return;
+            }
+        }
+
+        Publisher publisher;
+        Router router;
+        std::map<std::string, Client> clients;
+        std::uint64_t frame_number{0};
+        std::size_t num_ready{0};
+        std::size_t num_clients{0};
+        std::size_t max_missed_frames{30};
+        long timeout_millis{100};
+        float barrier_latency{0.0f};
+        std::uint64_t num_timeouts{0};
+    };
+
+#pragma mark - ClusterSyncClient
+    struct ClusterSyncClient {
+        // name has to be unique in cluster
+        void setup(const std::string &address, const std::string &name)
+        { setup(address, detail::barrier_endpoint(address), name); };
+        void setup(const std::string &state_address,
+                   const std::string &barrier_address,
+                   const std::string &name)
+        {
+            subscriber.connect(state_address);
+            dealer.setIdentity(name);
+            dealer.connect(barrier_address);
+            dealer.sendMultipart(detail::cluster_hello_command);
+        }
+
+        // wait next frame state from master. return false if timed out.
+        // if several frames are queued, latest one is used.
+        bool waitForFrame(long timeout_millis = 1000) {
+            const auto begin = std::chrono::steady_clock::now();
+            while(true) {
+                while(receive());
+                if(has_pending_frame) {
+                    has_pending_frame = false;
+                    return true;
+                }
+                const long remain = timeout_millis - static_cast<long>(detail::elapsed_millis(begin));
+                if(remain <= 0 || !subscriber.hasWaitingMessage(remain)) return false;
+            }
+        }
+
+        // call just before swap buffers. return false if timed out
+        bool waitForSwap(long timeout_millis = 100) {
+            const auto begin = std::chrono::steady_clock::now();
+            const std::uint64_t ready_frame = frame_number;
+            dealer.sendMultipart(detail::cluster_ready_command, ready_frame);
+            while(released_frame < ready_frame) {
+                const long remain = timeout_millis - static_cast<long>(detail::elapsed_millis(begin));
+                if(remain <= 0 || !subscriber.hasWaitingMessage(remain)) {
+                    ++num_timeouts;
+                    return false;
+                }
+                while(released_frame < ready_frame && receive());
+            }
+            barrier_latency = detail::elapsed_millis(begin);
+            return true;
+        }
+
+        std::uint64_t getFrameNum() const
+        { return frame_number; };
+        // state parts given to ClusterSyncMaster::beginFrame
+        const MultipartMessage &getState() const
+        { return state; };
+        // time from ready to release in last waitForSwap
+        float getBarrierLatency() const
+        { return barrier_latency; };
+        std::uint64_t getNumTimeouts() const
+        { return num_timeouts; };
+
+    protected:
+        // return false if no message
+        bool receive() {
+            MultipartMessage m;
+            if(!subscriber.receiveMultipart(m)) return false;
+            if(m.size() < 2) return true;
+            const std::string topic = m[0];
+            const std::uint64_t frame = m[1];
+            if(topic == detail::cluster_swap_topic) {
+                released_frame = std::max(released_frame, frame);
+            } else if(topic == detail::cluster_frame_topic && frame_number < frame) {
+                // master has gone ahead (e.g. our barrier timed out). keep it for next waitForFrame
+                frame_number = frame;
+                m.pop();
+                m.pop();
+                state = std::move(m);
+                has_pending_frame = true;
+            }
+            return true;
+        }
+
+        Subscriber subscriber;
+        Dealer dealer;
+        MultipartMessage state;
+        std::uint64_t frame_number{0};
+        std::uint64_t released_frame{0};
+        bool has_pending_frame{false};
+        float barrier_latency{0.0f};
+        std::uint64_t num_timeouts{0};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQClusterSyncMaster = ofxZeroMQ::ClusterSyncMaster;
+using ofxZeroMQClusterSyncClient = ofxZeroMQ::ClusterSyncClient;
+
+#endif /* ofxZeroMQClusterSync_h */
@@ -0,0 +1,271 @@
+//
+//  ofxZeroMQContentFilter.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQContentFilter_h
+#define ofxZeroMQContentFilter_h
+
+#include "ofxZeroMQ.h"
+
+#include <cstring>
+#include <limits>
+
+// usage:
+//
+// // publisher. header (second part) is array of floats, e.g. glm::vec2 position
+// ofxZeroMQFilteringPublisher pub;
+// pub.bind("tcp://*:26666");
+// pub.send("tracking/blob", glm::vec2(x, y), blob); // every frame
+//
+// // subscriber which needs only blobs in left half of stage
+// ofxZeroMQFilteringSubscriber sub;
+// sub.connect("tcp://localhost:26666");
+// sub.subscribe("tracking/", ofxZeroMQContentFilter().boundingBox(0, 0, 960, 1080));
+// ofxZeroMQMultipartMessage m;
+// while(sub.receiveMultipart(m)) { ... } // [topic][header][data ...] as sent
+//
+// topics can't contain '\0'. subscribers with filter "" receive filtered copies too.
+
+namespace ofxZeroMQ {
+#pragma mark - ContentFilter
+    // conjunction of closed ranges on float fields of header part
+    struct ContentFilter {
+        struct Range {
+            std::uint16_t field;
+            float min;
+            float max;
+        };
+
+        // field is index of float in header
+        ContentFilter &range(std::uint16_t field, float min, float max) {
+            ranges.push_back({field, min, max});
+            return *this;
+        }
+        ContentFilter &greaterEqual(std::uint16_t field, float min)
+        { return range(field, min, std::numeric_limits<float>::infinity()); };
+        ContentFilter &lessEqual(std::uint16_t field, float max)
+        { return range(field, -std::numeric_limits<float>::infinity(), max); };
+        // on fields x_field and x_field + 1
+        ContentFilter &boundingBox(float min_x, float min_y, float max_x, float max_y, std::uint16_t x_field = 0) {
+            range(x_field, min_x, max_x);
+            return range(x_field + 1, min_y, max_y);
+        }
+
+        // false if header is shorter than any field
+        bool matches(const void *header, std::size_t size) const {
+            for(const auto &r : ranges) {
+                if(size < (r.field + 1) * sizeof(float)) return false;
+                float v;
+                std::memcpy(&v, static_cast<const char *>(header) + r.field * sizeof(float), sizeof(float));
+                if(!(r.min <= v && v <= r.max)) return false;
+            }
+            return true;
+        }
+        bool matches(const Message &header) const
+        { return matches(header.data(), header.size()); };
+
+        const std::vector<Range> &getRanges() const
+        { return ranges; };
+
+    protected:
+        std::vector<Range> ranges;
+    };
+
+    namespace detail {
+        /* filtered subscription: ['\0'][topic prefix]['\0'][std::uint16_t num ranges]{[std::uint16_t field][float min][float max]} * num ranges
+         * filtered copy (PUB):   [filtered subscription][topic][header][data ...]
+         *
+         * SUB / XPUB match by byte prefix, so distinct subscriptions must never be prefix of each other.
+         * topic prefix is terminated by '\0' and followed by number of ranges, so keys of same length differ in content.
+         */
+        inline std::string encode_content_subscription(const std::string &prefix, const ContentFilter &filter) {
+            std::string key;
+            const std::uint16_t num = static_cast<std::uint16_t>(std::min<std::size_t>(filter.getRanges().size(), std::numeric_limits<std::uint16_t>::max()));
+            key.reserve(prefix.size() + 2 + sizeof(num) + num * 10);
+            key.push_back('\0');
+            key += prefix;
+            key.push_back('\0');
+            key.append(reinterpret_cast<const char *>(&num), sizeof(num));
+            for(std::size_t i = 0; i < num; ++i) {
+                const auto &r = filter.getRanges()[i];
+                key.append(reinterpret_cast<const char *>(&r.field), sizeof(r.field));
+                key.append(reinterpret_cast<const char *>(&r.min), sizeof(r.min));
+                key.append(reinterpret_cast<const char *>(&r.max), sizeof(r.max));
+            }
+            return key;
+        }
+
+        // return false if key is not filtered subscription
+        inline bool decode_content_subscription(const std::string &key, std::string &prefix, ContentFilter &filter) {
+            if(key.empty() || key[0] != '\0') return false;
+            const std::size_t end = key.find('\0', 1);
+            if(end == std::string::npos) return false;
+            prefix = key.substr(1, end - 1);
+            constexpr std::size_t range_size = sizeof(std::uint16_t) + sizeof(float) * 2;
+            std::uint16_t num;
+            if(key.size() < end + 1 + sizeof(num)) return false;
+            std::memcpy(&num, key.data() + end + 1, sizeof(num));
+            if(key.size() != end + 1 + sizeof(num) + num * range_size) return false;
+            for(std::size_t pos = end + 1 + sizeof(num); pos < key.size(); pos += range_size) {
+                std::uint16_t field;
+                float min, max;
+                std::memcpy(&field, key.data() + pos, sizeof(field));
+                std::memcpy(&min, key.data() + pos + sizeof(field), sizeof(min));
+                std::memcpy(&max, key.data() + pos + sizeof(field) + sizeof(min), sizeof(max));
+                filter.range(field, min, max);
+            }
+            return true;
+        }
+    }; // detail
+
+#pragma mark - FilteringPublisher
+    // XPUB which receives filters of subscribers as subscriptions, and evaluates them before fan-out.
+    // message is sent once as is for prefix subscribers, and once per matching filtered subscription.
+    // same filter of several subscribers is one subscription of XPUB, so it costs one evaluation.
+    struct FilteringPublisher {
+        void bind(const std::string &address)
+        { xpub.bind(address); };
+        void unbind(const std::string &address)
+        { xpub.unbind(address); };
+
+        // apply subscription notifications. called by send too
+        void update() {
+            MultipartMessage m;
+            while(xpub.receiveMultipart(m)) {
+                if(m.empty() || m.at(0).size() < 1) continue;
+                const char *data = static_cast<const char *>(m.at(0).data());
+                const bool is_subscribe = data[0] == 1;
+                const std::string key{data + 1, m.at(0).size() - 1};
+                std::string prefix;
+                ContentFilter filter;
+                if(!detail::decode_content_subscription(key, prefix, filter)) continue;
+                if(is_subscribe) add_subscription(prefix, key, std::move(filter));
+                else remove_subscription(prefix, key);
+            }
+        }
+
+        // header is second part of message, and has to be array of floats
+        template <typename header_type, typename ... types>
+        zmq::send_result_t send(const std::string &topic, header_type &&header, types && ... data) {
+            MultipartMessage message{topic, std::forward<header_type>(header), std::forward<types>(data) ...};
+            return send(message);
+        }
+
+        // [topic][header][data ...]
+        zmq::send_result_t send(MultipartMessage &message) {
+            update();
+            if(message.size() < 2) {
+                ofLogWarning("ofxZeroMQFilteringPublisher") << "message needs topic and header";
+                return {};
+            }
+            const Message &topic = message.at(0);
+            const Message &header = message.at(1);
+            subscriptions.match(topic.data(), topic.size(), [this, &message, &header](std::vector<Subscription> &filtered) {
+                for(auto &subscription : filtered) {
+                    if(!subscription.filter.matches(header)) {
+                        ++num_filtered_out;
+                        continue;
+                    }
+                    MultipartMessage copied;
+                    copied.addArgument(subscription.key);
+                    // zmq_msg_copy shares large buffers
+                    for(auto &part : message) {
+                        Message shared;
+                        shared.copy(part);
+                        copied.add(std::move(shared));
+                    }
+                    if(xpub.sendMultipart(std::move(copied))) ++num_filtered_sent;
+                }
+            });
+            return xpub.send(message);
+        }
+
+        std::size_t getNumFilteredSubscriptions() const
+        { return num_subscriptions; };
+        // copies sent to filtered subscriptions
+        std::uint64_t getNumFilteredSent() const
+        { return num_filtered_sent; };
+        // copies not sent because filter didn't match
+        std::uint64_t getNumFilteredOut() const
+        { return num_filtered_out; };
+
+        XPublisher &getSocket()
+        { return xpub; };
+
+    protected:
+        struct Subscription {
+            std::string key;
+            ContentFilter filter;
+        };
+
+        void add_subscription(const std::string &prefix, const std::string &key, ContentFilter &&filter) {
+            std::vector<Subscription> *filtered = subscriptions.find(prefix);
+            if(filtered == nullptr) {
+                subscriptions.insert(prefix, {});
+                filtered = subscriptions.find(prefix);
+            }
+            for(const auto &subscription : *filtered) if(subscription.key == key) return;
+            filtered->push_back({key, std::move(filter)});
+            ++num_subscriptions;
+        }
+
+        void remove_subscription(const std::string &prefix, const std::string &key) {
+            std::vector<Subscription> *filtered = subscriptions.find(prefix);
+            if(filtered == nullptr) return;
+            auto it = std::find_if(filtered->begin(), filtered->end(), [&key](const Subscription &subscription) { return subscription.key == key; });
+            if(it == filtered->end()) return;
+            filtered->erase(it);
+            --num_subscriptions;
+            if(filtered->empty()) subscriptions.erase(prefix);
+        }
+
+        XPublisher xpub;
+        detail::topic_trie<std::vector<Subscription>> subscriptions;
+        std::size_t num_subscriptions{0};
+        std::uint64_t num_filtered_sent{0};
+        std::uint64_t num_filtered_out{0};
+    };
+
+#pragma mark - FilteringSubscriber
+    struct FilteringSubscriber {
+        // connect of raw socket, because Subscriber::connect subscribes everything if no filter is added yet
+        void connect(const std::string &address)
+        { sub.getRawSocket().connect(address); };
+        void disconnect(const std::string &address)
+        { sub.disconnect(address); };
+
+        // receive messages of topics starting with prefix only if header matches filter.
+        // overlapping filters receive same message once per matching filter
+        void subscribe(const std::string &prefix, const ContentFilter &filter)
+        { sub.addFilter(detail::encode_content_subscription(prefix, filter)); };
+        bool unsubscribe(const std::string &prefix, const ContentFilter &filter)
+        { return sub.removeFilter(detail::encode_content_subscription(prefix, filter)); };
+
+        // whole topic without filtering
+        void subscribe(const std::string &prefix)
+        { sub.addFilter(prefix); };
+        bool unsubscribe(const std::string &prefix)
+        { return sub.removeFilter(prefix); };
+
+        // [topic][header][data ...]. filtered subscription part is removed
+        bool receiveMultipart(MultipartMessage &message, ReceiveFlag flags = ReceiveFlag{}) {
+            if(!sub.receiveMultipart(message, flags)) return false;
+            if(2 <= message.size() && 0 < message.at(0).size() && static_cast<const char *>(message.at(0).data())[0] == '\0') message.pop();
+            return true;
+        }
+
+        Subscriber &getSocket()
+        { return sub; };
+
+    protected:
+        Subscriber sub;
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQContentFilter = ofxZeroMQ::ContentFilter;
+using ofxZeroMQFilteringPublisher = ofxZeroMQ::FilteringPublisher;
+using ofxZeroMQFilteringSubscriber = ofxZeroMQ::FilteringSubscriber;
+
+#endif /* ofxZeroMQContentFilter_h */
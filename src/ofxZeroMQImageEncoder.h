@@ -0,0 +1,178 @@
+//
+//  ofxZeroMQImageEncoder.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQImageEncoder_h
+#define ofxZeroMQImageEncoder_h
+
+#include "ofxZeroMQ.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// usage:
+//
+// ofxZeroMQPublisher pub;
+// ofxZeroMQImageEncoder<ofxZeroMQPublisher> encoder{pub, "camera", {OF_IMAGE_FORMAT_JPEG, OF_IMAGE_QUALITY_HIGH}};
+//
+// void update() {
+//     grabber.update();
+//     if(grabber.isFrameNew()) encoder.send(grabber); // pixels are copied, encoded on worker threads
+//     encoder.update(); // send encoded frames in order
+// }
+//
+// // receiver needs nothing special
+// ofPixels pixels = m[1]; // decoded by ofLoadImage
+
+namespace ofxZeroMQ {
+#pragma mark - ImageEncoder
+    // encodes frames with ofSaveImage on worker threads, and sends them by update() on owner thread in order.
+    // if max_in_flight frames are already encoding, new frame is dropped instead of blocking caller.
+    template <typename socket_type>
+    struct ImageEncoder {
+        ImageEncoder(socket_type &socket,
+                     const std::string &topic = "",
+                     ImageEncoding encoding = ImageEncoding{},
+                     std::size_t num_threads = 0,
+                     std::size_t max_in_flight = 0)
+        : socket(socket)
+        , topic(topic)
+        , encoding(encoding)
+        {
+            if(num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+            this->max_in_flight = max_in_flight == 0 ? num_threads * 2 : max_in_flight;
+            for(std::size_t i = 0; i < num_threads; ++i) {
+                workers.emplace_back([this] { process(); });
+            }
+        }
+        ImageEncoder(const ImageEncoder &) = delete;
+        ImageEncoder &operator=(const ImageEncoder &) = delete;
+
+        // socket has to outlive this. encoded but unsent frames are discarded
+        ~ImageEncoder() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                is_running = false;
+            }
+            condition.notify_all();
+            for(auto &worker : workers) worker.join();
+        }
+
+        // applied from next frame
+        void setEncoding(ImageEncoding encoding) {
+            std::lock_guard<std::mutex> lock(mutex);
+            this->encoding = encoding;
+        }
+
+        // return false if frame is dropped
+        template <typename pix_type>
+        bool send(const ofPixels_<pix_type> &pixels) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(max_in_flight <= next_sequence - next_send_sequence) {
+                ++num_dropped;
+                return false;
+            }
+            const ImageEncoding encoding = this->encoding;
+            auto copied = std::make_shared<ofPixels_<pix_type>>(pixels);
+            jobs.push_back({next_sequence++, [copied, encoding](Message &m) {
+                return detail::encode_image(m, *copied, encoding);
+            }});
+            condition.notify_one();
+            return true;
+        }
+
+        template <typename pix_type>
+        bool send(const ofBaseHasPixels_<pix_type> &pixels)
+        { return send(pixels.getPixels()); };
+
+        // send encoded frames in order. return number of sent frames
+        std::size_t update() {
+            std::size_t num_sent = 0;
+            while(true) {
+                Message encoded;
+                bool is_succeeded;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    auto it = results.find(next_send_sequence);
+                    if(it == results.end()) break;
+                    encoded = std::move(it->second.message);
+                    is_succeeded = it->second.is_succeeded;
+                    results.erase(it);
+                    ++next_send_sequence;
+                }
+                if(!is_succeeded) continue;
+                MultipartMessage message;
+                if(!topic.empty()) message.addArgument(topic);
+                message.add(std::move(encoded));
+                if(socket.send(message)) ++num_sent;
+            }
+            return num_sent;
+        }
+
+        std::size_t getNumInFlight() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return static_cast<std::size_t>(next_sequence - next_send_sequence);
+        }
+        std::uint64_t getNumDropped() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return num_dropped;
+        }
+
+    protected:
+        struct Job {
+            std::uint64_t sequence;
+            std::function<bool(Message &)> encode;
+        };
+        struct Result {
+            Message message;
+            bool is_succeeded;
+        };
+
+        void process() {
+            while(true) {
+                Job job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock, [this] { return !is_running || !jobs.empty(); });
+                    if(!is_running) return;
+                    job = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+                Result result;
+                result.is_succeeded = job.encode(result.message);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    results.emplace(job.sequence, std::move(result));
+                }
+            }
+        }
+
+        socket_type &socket;
+        std::string topic;
+        ImageEncoding encoding;
+        std::size_t max_in_flight;
+
+        std::vector<std::thread> workers;
+        std::deque<Job> jobs;
+        std::map<std::uint64_t, Result> results;
+        std::uint64_t next_sequence{0};
+        std::uint64_t next_send_sequence{0};
+        std::uint64_t num_dropped{0};
+        bool is_running{true};
+        mutable std::mutex mutex;
+        std::condition_variable condition;
+    };
+}; // ofxZeroMQ
+
+template <typename socket_type>
+using ofxZeroMQImageEncoder = ofxZeroMQ::ImageEncoder<socket_type>;
+using ofxZeroMQImageEncoding = ofxZeroMQ::ImageEncoding;
+
+#endif /* ofxZeroMQImageEncoder_h */
@@ -0,0 +1,409 @@
+//
+//  ofxZeroMQParameterSync.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQParameterSync_h
+#define ofxZeroMQParameterSync_h
+
+#include "ofxZeroMQ.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <typeinfo>
+
+#include "ofParameter.h"
+#include "ofColor.h"
+
+// usage:
+//
+// // control machine
+// ofxZeroMQParameterSender sender;
+// sender.setup(gui_parameters);
+// sender.bind("tcp://*:26666");
+// void update() { sender.update(); } // changed parameters in this frame are sent as one message
+//
+// // render node (same group structure)
+// ofxZeroMQParameterReceiver receiver;
+// receiver.setup(parameters, "tcp://control:26666");
+// void update() { receiver.update(); }
+
+namespace ofxZeroMQ {
+    namespace detail {
+#pragma mark parameter codec
+        // typed value encoding of one parameter. id is index in parameter_codecs(), and has to be stable across versions
+        struct parameter_codec {
+            const char *type_name;
+            void (*encode)(const ofAbstractParameter &, std::string &);
+            // return read size, 0 if broken
+            std::size_t (*decode)(ofAbstractParameter &, const char *, std::size_t);
+        };
+
+        template <typename type>
+        struct trivial_parameter_codec {
+            static void encode(const ofAbstractParameter &parameter, std::string &out) {
+                const type &v = parameter.cast<type>().get();
+                out.append(reinterpret_cast<const char *>(&v), sizeof(type));
+            }
+            static std::size_t decode(ofAbstractParameter &parameter, const char *src, std::size_t available) {
+                if(available < sizeof(type)) return 0;
+                type v;
+                std::memcpy(&v, src, sizeof(type));
+                auto &p = parameter.cast<type>();
+                if(p.get() != v) p.set(v);
+                return sizeof(type);
+            }
+        };
+
+        struct bool_parameter_codec {
+            static void encode(const ofAbstractParameter &parameter, std::string &out)
+            { out.push_back(parameter.cast<bool>().get() ? 1 : 0); };
+            static std::size_t decode(ofAbstractParameter &parameter, const char *src, std::size_t available) {
+                if(available < 1) return 0;
+                auto &p = parameter.cast<bool>();
+                if(p.get() != (src[0] != 0)) p.set(src[0] != 0);
+                return 1;
+            }
+        };
+
+        inline void write_parameter_string(const std::string &str, std::string &out) {
+            const std::uint32_t size = static_cast<std::uint32_t>(str.size());
+            out.append(reinterpret_cast<const char *>(&size), sizeof(size));
+            out.append(str);
+        }
+        inline std::size_t read_parameter_string(const char *src, std::size_t available, std::string &str) {
+            std::uint32_t size;
+            if(available < sizeof(size)) return 0;
+            std::memcpy(&size, src, sizeof(size));
+            if(available - sizeof(size) < size) return 0;
+            str.assign(src + sizeof(size), size);
+            return sizeof(size) + size;
+        }
+
+        struct string_parameter_codec {
+            static void encode(const ofAbstractParameter &parameter, std::string &out)
+            { write_parameter_string(parameter.cast<std::string>().get(), out); };
+            static std::size_t decode(ofAbstractParameter &parameter, const char *src, std::size_t available) {
+                std::string str;
+                const std::size_t size = read_parameter_string(src, available, str);
+                auto &p = parameter.cast<std::string>();
+                if(size && p.get() != str) p.set(str);
+                return size;
+            }
+        };
+
+        // other serializable types are sent by toString / fromString
+        struct generic_parameter_codec {
+            static void encode(const ofAbstractParameter &parameter, std::string &out)
+            { write_parameter_string(parameter.toString(), out); };
+            static std::size_t decode(ofAbstractParameter &parameter, const char *src, std::size_t available) {
+                std::string str;
+                const std::size_t size = read_parameter_string(src, available, str);
+                if(size && parameter.toString() != str) parameter.fromString(str);
+                return size;
+            }
+        };
+
+        template <typename type>
+        parameter_codec make_trivial_parameter_codec()
+        { return { typeid(type).name(), &trivial_parameter_codec<type>::encode, &trivial_parameter_codec<type>::decode }; };
+
+        // last one is generic codec
+        inline const std::vector<parameter_codec> &parameter_codecs() {
+            static const std::vector<parameter_codec> codecs{
+                { typeid(bool).name(), &bool_parameter_codec::encode, &bool_parameter_codec::decode },
+                make_trivial_parameter_codec<int>(),
+                make_trivial_parameter_codec<unsigned int>(),
+                make_trivial_parameter_codec<std::int64_t>(),
+                make_trivial_parameter_codec<std::uint64_t>(),
+                make_trivial_parameter_codec<float>(),
+                make_trivial_parameter_codec<double>(),
+                make_trivial_parameter_codec<glm::vec2>(),
+                make_trivial_parameter_codec<glm::vec3>(),
+                make_trivial_parameter_codec<glm::vec4>(),
+                make_trivial_parameter_codec<ofColor>(),
+                make_trivial_parameter_codec<ofShortColor>(),
+                make_trivial_parameter_codec<ofFloatColor>(),
+                { typeid(std::string).name(), &string_parameter_codec::encode, &string_parameter_codec::decode },
+                { "", &generic_parameter_codec::encode, &generic_parameter_codec::decode },
+            };
+            return codecs;
+        }
+
+#pragma mark parameter layout
+        /* message:
+         *   std::uint32_t layout_hash
+         *   std::uint32_t is_full
+         *   std::uint64_t sequence
+         *   std::uint32_t num_parameters
+         *   std::uint32_t reserved
+         *   { std::uint16_t index, value } * num_parameters
+         */
+        struct parameter_header {
+            std::uint32_t layout_hash;
+            std::uint32_t is_full;
+            std::uint64_t sequence;
+            std::uint32_t num_parameters;
+            std::uint32_t reserved;
+        };
+
+        // flattened serializable parameters of group in depth first order
+        struct parameter_layout {
+            void build(ofParameterGroup &group) {
+                parameters.clear();
+                codecs.clear();
+                indices.clear();
+                hash = 2166136261u;
+                add(group);
+            }
+
+            // return -1 if not in layout
+            int find(const ofAbstractParameter &parameter) const {
+                auto it = indices.find(path(parameter));
+                return it == indices.end() ? -1 : it->second;
+            }
+
+            void encode(std::uint16_t index, std::string &out) const {
+                out.append(reinterpret_cast<const char *>(&index), sizeof(index));
+                codecs[index]->encode(*parameters[index], out);
+            }
+
+            // return read size, 0 if broken
+            std::size_t decode(const char *src, std::size_t available) const {
+                std::uint16_t index;
+                if(available < sizeof(index)) return 0;
+                std::memcpy(&index, src, sizeof(index));
+                if(parameters.size() <= index) return 0;
+                const std::size_t size = codecs[index]->decode(*parameters[index], src + sizeof(index), available - sizeof(index));
+                return size ? sizeof(index) + size : 0;
+            }
+
+            static std::string path(const ofAbstractParameter &parameter) {
+                std::string path;
+                for(const auto &name : parameter.getGroupHierarchyNames()) {
+                    path += name;
+                    path += '/';
+                }
+                return path;
+            }
+
+            std::vector<std::shared_ptr<ofAbstractParameter>> parameters;
+            std::vector<const parameter_codec *> codecs;
+            std::map<std::string, int> indices;
+            // FNV-1a of paths and codec ids. typeid names are compiler dependent, so not used
+            std::uint32_t hash;
+            // index is std::uint16_t
+            static constexpr std::size_t max_parameters = 65536;
+
+        private:
+            void add(ofParameterGroup &group) {
+                for(auto &parameter : group) {
+                    if(parameter->type() == typeid(ofParameterGroup).name()) {
+                        add(parameter->castGroup());
+                        continue;
+                    }
+                    if(!parameter->isSerializable()) continue;
+                    if(parameters.size() == max_parameters) {
+                        ofLogWarning("ofxZeroMQParameterSync") << "too many parameters. only first " << max_parameters << " are synchronized";
+                        return;
+                    }
+                    const auto &all = parameter_codecs();
+                    std::size_t id = 0;
+                    while(id + 1 < all.size() && parameter->valueType() != all[id].type_name) ++id;
+                    const std::string key = path(*parameter);
+                    if(!indices.emplace(key, static_cast<int>(parameters.size())).second) {
+                        ofLogWarning("ofxZeroMQParameterSync") << "duplicated parameter path " << key << ". only first one is synchronized";
+                    }
+                    parameters.push_back(parameter);
+                    codecs.push_back(&all[id]);
+                    for(auto c : key) mix(static_cast<unsigned char>(c));
+                    mix(static_cast<unsigned char>(id));
+                }
+            }
+
+            void mix(unsigned char c) {
+                hash ^= c;
+                hash *= 16777619u;
+            }
+        };
+    }; // detail
+
+#pragma mark - ParameterSender
+    // sends only parameters changed since last update, as index + binary value.
+    // whole group is sent periodically for late joiners / lost messages.
+    struct ParameterSender {
+        ParameterSender() {};
+        ParameterSender(const ParameterSender &) = delete;
+        ParameterSender &operator=(const ParameterSender &) = delete;
+
+        // topic is group name if empty. group structure has to be same as receivers
+        void setup(ofParameterGroup &group, const std::string &topic = "") {
+            this->topic = topic.empty() ? group.getName() : topic;
+            layout.build(group);
+            dirty.assign(layout.parameters.size(), false);
+            changed.clear();
+            listener = group.parameterChangedE().newListener([this](ofAbstractParameter &parameter) {
+                on_changed(parameter);
+            });
+            last_full_sync = {};
+        }
+
+        void bind(const std::string &address)
+        { publisher.bind(address); };
+        void connect(const std::string &address)
+        { publisher.connect(address); };
+
+        // 0 disables periodic full sync
+        void setFullSyncInterval(float seconds)
+        { full_sync_interval = seconds; };
+
+        // send parameters changed since last call as one message. return false if nothing is sent
+        bool update() {
+            const auto now = std::chrono::steady_clock::now();
+            if(0.0f < full_sync_interval && std::chrono::duration<float>(full_sync_interval) <= now - last_full_sync) {
+                return sendAll();
+            }
+            std::vector<std::uint16_t> indices;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(changed.empty()) return false;
+                indices.swap(changed);
+                for(auto index : indices) dirty[index] = false;
+            }
+            return send(indices, false);
+        }
+
+        bool sendAll() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for(auto index : changed) dirty[index] = false;
+                changed.clear();
+            }
+            std::vector<std::uint16_t> indices(layout.parameters.size());
+            for(std::size_t i = 0; i < indices.size(); ++i) indices[i] = static_cast<std::uint16_t>(i);
+            last_full_sync = std::chrono::steady_clock::now();
+            return send(indices, true);
+        }
+
+        std::size_t getNumParameters() const
+        { return layout.parameters.size(); };
+        std::size_t getLastMessageSize() const
+        { return last_message_size; };
+
+        Publisher &getPublisher()
+        { return publisher; };
+
+    protected:
+        // parameter may be changed from other thread (e.g. audio thread)
+        void on_changed(ofAbstractParameter &parameter) {
+            const int index = layout.find(parameter);
+            if(index < 0) return;
+            std::lock_guard<std::mutex> lock(mutex);
+            if(dirty[index]) return;
+            dirty[index] = true;
+            changed.push_back(static_cast<std::uint16_t>(index));
+        }
+
+        bool send(const std::vector<std::uint16_t> &indices, bool is_full) {
+            detail::parameter_header header;
+            header.layout_hash = layout.hash;
+            header.is_full = is_full ? 1 : 0;
+            header.sequence = sequence++;
+            header.num_parameters = static_cast<std::uint32_t>(indices.size());
+            header.reserved = 0;
+            buffer.assign(reinterpret_cast<const char *>(&header), sizeof(header));
+            for(auto index : indices) layout.encode(index, buffer);
+            last_message_size = buffer.size();
+            return publisher.sendMultipart(topic, buffer).has_value();
+        }
+
+        Publisher publisher;
+        std::string topic;
+        detail::parameter_layout layout;
+        ofEventListener listener;
+
+        std::mutex mutex;
+        std::vector<bool> dirty;
+        std::vector<std::uint16_t> changed;
+
+        std::string buffer;
+        std::uint64_t sequence{0};
+        float full_sync_interval{1.0f};
+        std::chrono::steady_clock::time_point last_full_sync;
+        std::size_t last_message_size{0};
+    };
+
+#pragma mark - ParameterReceiver
+    struct ParameterReceiver {
+        // topic is group name if empty
+        void setup(ofParameterGroup &group,
+                   const std::string &address,
+                   const std::string &topic = "")
+        {
+            layout.build(group);
+            subscriber.addFilter(topic.empty() ? group.getName() : topic);
+            subscriber.connect(address);
+            is_synced = false;
+        }
+
+        // apply received changes. parameter events are notified on this thread
+        void update() {
+            MultipartMessage m;
+            while(subscriber.receiveMultipart(m)) {
+                if(m.size() < 2) continue;
+                apply(m.at(1));
+            }
+        }
+
+        // false until first full sync, or while layout of sender is different
+        bool isSynced() const
+        { return is_synced; };
+        std::uint64_t getNumLostMessages() const
+        { return num_lost_messages; };
+
+    protected:
+        void apply(const zmq::message_t &m) {
+            detail::parameter_header header;
+            if(m.size() < sizeof(header)) return;
+            std::memcpy(&header, m.data(), sizeof(header));
+            if(header.layout_hash != layout.hash) {
+                if(is_synced || !is_mismatch_warned) {
+                    ofLogWarning("ofxZeroMQParameterReceiver") << "parameter group structure is different from sender";
+                    is_mismatch_warned = true;
+                }
+                is_synced = false;
+                return;
+            }
+            // lost changes are recovered by next full sync. smaller sequence means restarted sender, not loss
+            if(is_synced && last_sequence + 1 < header.sequence) num_lost_messages += header.sequence - last_sequence - 1;
+            last_sequence = header.sequence;
+            if(header.is_full) is_synced = true;
+
+            const char *p = static_cast<const char *>(m.data()) + sizeof(header);
+            std::size_t available = m.size() - sizeof(header);
+            for(std::uint32_t i = 0; i < header.num_parameters; ++i) {
+                const std::size_t size = layout.decode(p, available);
+                if(size == 0) {
+                    ofLogWarning("ofxZeroMQParameterReceiver") << "broken message";
+                    return;
+                }
+                p += size;
+                available -= size;
+            }
+        }
+
+        Subscriber subscriber;
+        detail::parameter_layout layout;
+        std::uint64_t last_sequence{0};
+        std::uint64_t num_lost_messages{0};
+        bool is_synced{false};
+        bool is_mismatch_warned{false};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQParameterSender = ofxZeroMQ::ParameterSender;
+using ofxZeroMQParameterReceiver = ofxZeroMQ::ParameterReceiver;
+
+#endif /* ofxZeroMQParameterSync_h */
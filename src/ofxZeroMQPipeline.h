@@ -0,0 +1,355 @@
+//
+//  ofxZeroMQPipeline.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQPipeline_h
+#define ofxZeroMQPipeline_h
+
+#include "ofxZeroMQ.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+#include <thread>
+
+// usage:
+//
+// // ventilator
+// ofxZeroMQPipelineVentilator ventilator;
+// ventilator.bind("tcp://*:26666");
+// for(auto &path : frame_paths) ventilator.submit(path);
+// ventilator.update(); // every frame. dispatches tasks to workers which have credits
+//
+// // workers (any number of machines, one thread per core by default)
+// ofxZeroMQPipelineWorker worker;
+// worker.setup("tcp://ventilator:26666", "tcp://sink:26667",
+//              [](const ofxZeroMQMultipartMessage &task, ofxZeroMQMultipartMessage &result) {
+//     ofPixels pixels;
+//     ofLoadImage(pixels, task[0].get<std::string>());
+//     result.addArgument(analyze(pixels));
+// });
+//
+// // sink
+// ofxZeroMQPipelineSink sink;
+// sink.bind("tcp://*:26667");
+// ofxZeroMQMultipartMessage result;
+// while(sink.receive(result)) { ... } // in order of submit
+
+namespace ofxZeroMQ {
+    namespace detail {
+        /* protocol:
+         * worker -> ventilator  [Ready][std::uint32_t credits]
+         *                       [Done][std::uint64_t task id]
+         * ventilator -> worker  [Task][std::uint64_t task id][task ...]
+         * worker -> sink        [std::uint64_t task id][result ...]
+         */
+        enum class pipeline_command : std::uint8_t {
+            Ready = 0,
+            Task = 1,
+            Done = 2,
+        };
+
+        // completed / seconds since start
+        struct throughput_counter {
+            void count(std::uint64_t num = 1) {
+                if(completed == 0 && !is_started) start();
+                completed += num;
+            }
+            void start() {
+                begin = std::chrono::steady_clock::now();
+                is_started = true;
+            }
+            float get() const {
+                if(!is_started) return 0.0f;
+                const float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - begin).count();
+                return 0.0f < seconds ? completed / seconds : 0.0f;
+            }
+
+            std::uint64_t completed{0};
+            std::chrono::steady_clock::time_point begin;
+            bool is_started{false};
+        };
+    }; // detail
+
+#pragma mark - PipelineVentilator
+    // distributes tasks to workers by credit, so each worker has at most its credits of tasks in flight.
+    // tasks not completed in task timeout are dispatched again (sink ignores duplicated results).
+    struct PipelineVentilator {
+        void bind(const std::string &address)
+        { router.bind(address); };
+
+        // 0 disables re-dispatch. set this if workers may die, otherwise their tasks are lost
+        void setTaskTimeout(long timeout_millis)
+        { task_timeout_millis = timeout_millis; };
+
+        // return task id. task ids are sequential from 0, and sink orders results by them
+        template <typename ... types>
+        std::uint64_t submit(types && ... task) {
+            if(!throughput.is_started) throughput.start();
+            queue.push_back({next_task_id, MultipartMessage{std::forward<types>(task) ...}});
+            return next_task_id++;
+        }
+
+        // receive credits / completions, and dispatch queued tasks. call every frame
+        void update() {
+            MultipartMessage m;
+            while(router.receiveMultipart(m)) {
+                if(m.size() < 3) continue;
+                const std::string identity = m[0];
+                const auto command = m[1].get<detail::pipeline_command>();
+                if(command == detail::pipeline_command::Ready) {
+                    workers[identity].credits += m[2].get<std::uint32_t>();
+                } else if(command == detail::pipeline_command::Done) {
+                    ++workers[identity].credits;
+                    if(0 < in_flight.erase(m[2].get<std::uint64_t>())) throughput.count();
+                }
+            }
+            if(0 < task_timeout_millis) requeue_expired();
+            dispatch();
+        }
+
+        std::uint64_t getNumSubmitted() const
+        { return next_task_id; };
+        std::uint64_t getNumCompleted() const
+        { return throughput.completed; };
+        std::size_t getNumQueued() const
+        { return queue.size(); };
+        std::size_t getNumInFlight() const
+        { return in_flight.size(); };
+        std::size_t getNumWorkers() const
+        { return workers.size(); };
+        std::uint64_t getNumRetried() const
+        { return num_retried; };
+        // completed / submitted
+        float getProgress() const
+        { return next_task_id ? static_cast<float>(throughput.completed) / next_task_id : 0.0f; };
+        // completed tasks per second since first submit
+        float getThroughput() const
+        { return throughput.get(); };
+        bool isFinished() const
+        { return queue.empty() && in_flight.empty(); };
+
+    protected:
+        struct Task {
+            std::uint64_t id;
+            MultipartMessage body;
+        };
+        struct InFlight {
+            MultipartMessage body;
+            std::chrono::steady_clock::time_point sent;
+        };
+        struct Worker {
+            std::uint32_t credits{0};
+        };
+
+        void dispatch() {
+            while(!queue.empty()) {
+                // worker which has most credits
+                auto target = workers.end();
+                for(auto it = workers.begin(); it != workers.end(); ++it) {
+                    if(0 < it->second.credits && (target == workers.end() || target->second.credits < it->second.credits)) target = it;
+                }
+                if(target == workers.end()) return;
+
+                Task &task = queue.front();
+                MultipartMessage m;
+                m.addArgument(target->first);
+                m.addArgument(detail::pipeline_command::Task);
+                m.addArgument(task.id);
+                // keep body for re-dispatch. zmq_msg_copy shares large buffers
+                for(auto &part : task.body) {
+                    Message shared;
+                    shared.copy(part);
+                    m.add(std::move(shared));
+                }
+                // unreachable worker (e.g. disconnected) is dropped silently by ROUTER, and task is retried by timeout
+                router.sendMultipart(std::move(m));
+                --target->second.credits;
+                in_flight[task.id] = {std::move(task.body), std::chrono::steady_clock::now()};
+                queue.pop_front();
+            }
+        }
+
+        void requeue_expired() {
+            const auto now = std::chrono::steady_clock::now();
+            const auto timeout = std::chrono::milliseconds(task_timeout_millis);
+            std::vector<Task> expired;
+            for(auto it = in_flight.begin(); it != in_flight.end();) {
+                if(now - it->second.sent < timeout) {
+                    ++it;
+                    continue;
+                }
+                expired.push_back({it->first, std::move(it->second.body)});
+                it = in_flight.erase(it);
+            }
+            // before new tasks, in order of id
+            num_retried += expired.size();
+            queue.insert(queue.begin(), std::make_move_iterator(expired.begin()), std::make_move_iterator(expired.end()));
+        }
+
+        Router router;
+        std::map<std::string, Worker> workers;
+        std::deque<Task> queue;
+        std::map<std::uint64_t, InFlight> in_flight;
+        std::uint64_t next_task_id{0};
+        std::uint64_t num_retried{0};
+        long task_timeout_millis{0};
+        detail::throughput_counter throughput;
+    };
+
+#pragma mark - PipelineWorker
+    // runs task function on worker threads. each thread has own sockets and credits
+    struct PipelineWorker {
+        using TaskFunction = std::function<void(const MultipartMessage &task, MultipartMessage &result)>;
+
+        PipelineWorker() {};
+        PipelineWorker(const PipelineWorker &) = delete;
+        PipelineWorker &operator=(const PipelineWorker &) = delete;
+
+        ~PipelineWorker()
+        { stop(); };
+
+        // credits is number of tasks prefetched by each thread. 2 hides network latency without starving other workers
+        void setup(const std::string &ventilator_address,
+                   const std::string &sink_address,
+                   TaskFunction function,
+                   std::size_t num_threads = 0,
+                   std::uint32_t credits = 2)
+        {
+            stop();
+            if(num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+            is_running = true;
+            for(std::size_t i = 0; i < num_threads; ++i) {
+                threads.emplace_back([this, ventilator_address, sink_address, function, credits] { process(ventilator_address, sink_address, function, credits); });
+            }
+        }
+
+        void stop() {
+            is_running = false;
+            for(auto &thread : threads) thread.join();
+            threads.clear();
+        }
+
+        std::uint64_t getNumProcessed() const
+        { return num_processed; };
+
+    protected:
+        void process(const std::string &ventilator_address,
+                     const std::string &sink_address,
+                     const TaskFunction &function,
+                     std::uint32_t credits)
+        {
+            Dealer dealer;
+            Push push;
+            dealer.connect(ventilator_address);
+            push.connect(sink_address);
+            dealer.sendMultipart(detail::pipeline_command::Ready, credits);
+            MultipartMessage m;
+            while(is_running) {
+                if(!dealer.hasWaitingMessage(100)) continue;
+                while(is_running && dealer.receiveMultipart(m)) {
+                    if(m.size() < 2 || m[0].get<detail::pipeline_command>() != detail::pipeline_command::Task) continue;
+                    const auto id = m[1].get<std::uint64_t>();
+                    m.pop();
+                    m.pop();
+                    MultipartMessage result;
+                    result.addArgument(id);
+                    MultipartMessage body;
+                    function(m, body);
+                    while(!body.empty()) result.add(body.pop());
+                    // wait while sink is at HWM instead of dropping result
+                    while(!detail::send_multipart(push.getRawSocket(), result, zmq::send_flags::dontwait)) {
+                        if(!is_running) return;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                    dealer.sendMultipart(detail::pipeline_command::Done, id);
+                    ++num_processed;
+                }
+            }
+        }
+
+        std::vector<std::thread> threads;
+        std::atomic_bool is_running{false};
+        std::atomic<std::uint64_t> num_processed{0};
+    };
+
+#pragma mark - PipelineSink
+    struct PipelineSink {
+        void bind(const std::string &address)
+        { pull.bind(address); };
+
+        // if false, results are received in order of arrival. call before first receive
+        void setOrdered(bool ordered)
+        { is_ordered = ordered; };
+        // used only for getProgress
+        void setNumTasks(std::uint64_t num)
+        { num_tasks = num; };
+
+        // return false if next result is not arrived yet
+        bool receive(MultipartMessage &result) {
+            std::uint64_t id;
+            return receive(id, result);
+        }
+
+        bool receive(std::uint64_t &id, MultipartMessage &result) {
+            MultipartMessage m;
+            while(pull.receiveMultipart(m)) {
+                if(m.size() < 1) continue;
+                const auto received_id = m[0].get<std::uint64_t>();
+                m.pop();
+                // duplicated by re-dispatch
+                if(received_id < next_id) continue;
+                if(!is_ordered) {
+                    if(!received.insert(received_id).second) continue;
+                    // keep only ids above contiguous range
+                    while(received.erase(next_id)) ++next_id;
+                    throughput.count();
+                    id = received_id;
+                    result = std::move(m);
+                    return true;
+                }
+                if(!pending.emplace(received_id, std::move(m)).second) continue;
+                throughput.count();
+            }
+            if(!is_ordered) return false;
+            auto it = pending.find(next_id);
+            if(it == pending.end()) return false;
+            id = next_id;
+            result = std::move(it->second);
+            pending.erase(it);
+            ++next_id;
+            return true;
+        }
+
+        std::uint64_t getNumReceived() const
+        { return throughput.completed; };
+        // results waiting for earlier ones
+        std::size_t getNumPending() const
+        { return pending.size(); };
+        float getProgress() const
+        { return num_tasks ? static_cast<float>(throughput.completed) / num_tasks : 0.0f; };
+        // results per second since first result
+        float getThroughput() const
+        { return throughput.get(); };
+
+    protected:
+        Pull pull;
+        std::map<std::uint64_t, MultipartMessage> pending;
+        // ids received out of order, only for unordered mode
+        std::set<std::uint64_t> received;
+        std::uint64_t next_id{0};
+        std::uint64_t num_tasks{0};
+        bool is_ordered{true};
+        detail::throughput_counter throughput;
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQPipelineVentilator = ofxZeroMQ::PipelineVentilator;
+using ofxZeroMQPipelineWorker = ofxZeroMQ::PipelineWorker;
+using ofxZeroMQPipelineSink = ofxZeroMQ::PipelineSink;
+
+#endif /* ofxZeroMQPipeline_h */
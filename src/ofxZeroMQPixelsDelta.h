@@ -0,0 +1,272 @@
+//
+//  ofxZeroMQPixelsDelta.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQPixelsDelta_h
+#define ofxZeroMQPixelsDelta_h
+
+#include "ofxZeroMQ.h"
+
+// usage:
+//
+// // sender
+// ofxZeroMQPixelsDeltaEncoder encoder;
+// pub.sendMultipart("canvas", encoder.encode(fbo_pixels)); // only changed tiles, keyframe every 60 frames
+//
+// // receiver
+// ofxZeroMQPixelsDeltaDecoder decoder;
+// if(decoder.decode(m.at(1))) texture.loadData(decoder.getPixels());
+
+namespace ofxZeroMQ {
+    namespace detail {
+        /* delta frame:
+         *   std::uint32_t magic
+         *   std::uint32_t is_keyframe
+         *   std::uint64_t frame_number
+         *   std::uint32_t width, height, tile_size, bytes_per_channel
+         *   ofPixelFormat pixel_format
+         *   std::uint32_t num_tiles
+         *   keyframe: all pixels
+         *   otherwise: { std::uint32_t tile_index, tile rows } * num_tiles
+         * tiles on right / bottom edge are clipped by image size.
+         */
+        static constexpr std::uint32_t delta_pixels_magic = 0x545A464F; // "OFZT"
+
+        struct delta_pixels_header {
+            std::uint32_t magic;
+            std::uint32_t is_keyframe;
+            std::uint64_t frame_number;
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint32_t tile_size;
+            std::uint32_t bytes_per_channel;
+            ofPixelFormat pixel_format;
+            std::uint32_t num_tiles;
+        };
+
+        struct tile_layout {
+            tile_layout(std::size_t width,
+                        std::size_t height,
+                        std::size_t tile_size,
+                        std::size_t bytes_per_pixel)
+            : width(width)
+            , height(height)
+            , tile_size(tile_size)
+            , bytes_per_pixel(bytes_per_pixel)
+            , num_columns((width + tile_size - 1) / tile_size)
+            , num_rows((height + tile_size - 1) / tile_size)
+            {};
+
+            std::size_t size() const
+            { return num_columns * num_rows; };
+
+            std::size_t x(std::size_t tile) const
+            { return (tile % num_columns) * tile_size; };
+            std::size_t y(std::size_t tile) const
+            { return (tile / num_columns) * tile_size; };
+            std::size_t row_bytes(std::size_t tile) const
+            { return std::min(tile_size, width - x(tile)) * bytes_per_pixel; };
+            std::size_t rows(std::size_t tile) const
+            { return std::min(tile_size, height - y(tile)); };
+            std::size_t bytes(std::size_t tile) const
+            { return row_bytes(tile) * rows(tile); };
+            std::size_t offset(std::size_t tile, std::size_t row) const
+            { return ((y(tile) + row) * width + x(tile)) * bytes_per_pixel; };
+
+            std::size_t width, height, tile_size, bytes_per_pixel;
+            std::size_t num_columns, num_rows;
+        };
+    }; // detail
+
+#pragma mark - PixelsDeltaEncoder
+    template <typename pix_type>
+    struct PixelsDeltaEncoder {
+        void setTileSize(std::uint32_t size) {
+            tile_size = 0 < size ? size : 1;
+            requestKeyframe();
+        }
+        // 0 means only first frame / size change
+        void setKeyframeInterval(std::uint32_t frames)
+        { keyframe_interval = frames; };
+        // next frame is sent as keyframe. e.g. when new subscriber is connected
+        void requestKeyframe()
+        { is_keyframe_requested = true; };
+
+        // returned message is sent as one part
+        Message encode(const ofPixels_<pix_type> &pixels) {
+            const std::size_t bytes_per_pixel = pixels.getNumChannels() * sizeof(pix_type);
+            const detail::tile_layout layout{pixels.getWidth(), pixels.getHeight(), tile_size, bytes_per_pixel};
+            const char *current = reinterpret_cast<const char *>(pixels.getData());
+
+            bool is_keyframe = is_keyframe_requested
+                || previous.getWidth() != pixels.getWidth()
+                || previous.getHeight() != pixels.getHeight()
+                || previous.getPixelFormat() != pixels.getPixelFormat()
+                || (0 < keyframe_interval && keyframe_interval <= frames_since_keyframe);
+
+            changed_tiles.clear();
+            std::size_t payload_size = 0;
+            if(!is_keyframe) {
+                const char *last = reinterpret_cast<const char *>(previous.getData());
+                for(std::size_t tile = 0; tile < layout.size(); ++tile) {
+                    const std::size_t row_bytes = layout.row_bytes(tile);
+                    for(std::size_t row = 0; row < layout.rows(tile); ++row) {
+                        const std::size_t offset = layout.offset(tile, row);
+                        // memcmp is vectorized by libc
+                        if(std::memcmp(current + offset, last + offset, row_bytes) != 0) {
+                            changed_tiles.push_back(static_cast<std::uint32_t>(tile));
+                            payload_size += sizeof(std::uint32_t) + layout.bytes(tile);
+                            break;
+                        }
+                    }
+                }
+                // full frame is cheaper
+                if(pixels.getTotalBytes() <= payload_size) is_keyframe = true;
+            }
+            if(is_keyframe) payload_size = pixels.getTotalBytes();
+
+            detail::delta_pixels_header header;
+            header.magic = detail::delta_pixels_magic;
+            header.is_keyframe = is_keyframe ? 1 : 0;
+            header.width = static_cast<std::uint32_t>(pixels.getWidth());
+            header.height = static_cast<std::uint32_t>(pixels.getHeight());
+            header.tile_size = tile_size;
+            header.bytes_per_channel = sizeof(pix_type);
+            header.pixel_format = pixels.getPixelFormat();
+            header.frame_number = frame_number++;
+            header.num_tiles = static_cast<std::uint32_t>(is_keyframe ? layout.size() : changed_tiles.size());
+
+            Message m;
+            m.rebuild(sizeof(header) + payload_size);
+            char *p = static_cast<char *>(m.data());
+            std::memcpy(p, &header, sizeof(header));
+            p += sizeof(header);
+            if(is_keyframe) {
+                std::memcpy(p, current, pixels.getTotalBytes());
+                previous = pixels;
+                is_keyframe_requested = false;
+                frames_since_keyframe = 1;
+                return m;
+            }
+
+            char *last = reinterpret_cast<char *>(previous.getData());
+            for(auto tile : changed_tiles) {
+                std::memcpy(p, &tile, sizeof(tile));
+                p += sizeof(tile);
+                const std::size_t row_bytes = layout.row_bytes(tile);
+                for(std::size_t row = 0; row < layout.rows(tile); ++row) {
+                    const std::size_t offset = layout.offset(tile, row);
+                    std::memcpy(p, current + offset, row_bytes);
+                    std::memcpy(last + offset, current + offset, row_bytes);
+                    p += row_bytes;
+                }
+            }
+            ++frames_since_keyframe;
+            return m;
+        }
+
+        Message encode(const ofBaseHasPixels_<pix_type> &pixels)
+        { return encode(pixels.getPixels()); };
+
+        // number of changed tiles in last delta frame
+        std::size_t getNumChangedTiles() const
+        { return changed_tiles.size(); };
+
+    protected:
+        ofPixels_<pix_type> previous;
+        std::vector<std::uint32_t> changed_tiles;
+        std::uint32_t tile_size{32};
+        std::uint32_t keyframe_interval{60};
+        std::uint32_t frames_since_keyframe{0};
+        std::uint64_t frame_number{0};
+        bool is_keyframe_requested{true};
+    };
+
+#pragma mark - PixelsDeltaDecoder
+    template <typename pix_type>
+    struct PixelsDeltaDecoder {
+        // return true if pixels is updated.
+        // after lost frame (e.g. PUB/SUB dropped by HWM), delta frames are ignored until next keyframe.
+        bool decode(const zmq::message_t &m) {
+            detail::delta_pixels_header header;
+            if(m.size() < sizeof(header)) return false;
+            std::memcpy(&header, m.data(), sizeof(header));
+            if(header.magic != detail::delta_pixels_magic || header.bytes_per_channel != sizeof(pix_type)) {
+                ofLogWarning("ofxZeroMQPixelsDeltaDecoder") << "not a delta frame";
+                return false;
+            }
+            const char *p = static_cast<const char *>(m.data()) + sizeof(header);
+            const std::size_t payload_size = m.size() - sizeof(header);
+
+            if(header.is_keyframe) {
+                pixels.allocate(header.width, header.height, header.pixel_format);
+                if(payload_size < pixels.getTotalBytes()) {
+                    has_keyframe = false;
+                    return false;
+                }
+                std::memcpy(pixels.getData(), p, pixels.getTotalBytes());
+                has_keyframe = true;
+                last_frame_number = header.frame_number;
+                return true;
+            }
+
+            if(!has_keyframe
+               || header.frame_number != last_frame_number + 1
+               || header.width != pixels.getWidth()
+               || header.height != pixels.getHeight())
+            {
+                has_keyframe = false;
+                return false;
+            }
+
+            // tile_size is divisor of layout
+            if(header.tile_size == 0) return broken();
+            const detail::tile_layout layout{pixels.getWidth(), pixels.getHeight(), header.tile_size, pixels.getNumChannels() * sizeof(pix_type)};
+            if(layout.size() < header.num_tiles) return broken();
+            char *dst = reinterpret_cast<char *>(pixels.getData());
+            const char *end = p + payload_size;
+            for(std::uint32_t i = 0; i < header.num_tiles; ++i) {
+                std::uint32_t tile;
+                if(static_cast<std::size_t>(end - p) < sizeof(tile)) return broken();
+                std::memcpy(&tile, p, sizeof(tile));
+                p += sizeof(tile);
+                if(layout.size() <= tile || static_cast<std::size_t>(end - p) < layout.bytes(tile)) return broken();
+                const std::size_t row_bytes = layout.row_bytes(tile);
+                for(std::size_t row = 0; row < layout.rows(tile); ++row) {
+                    std::memcpy(dst + layout.offset(tile, row), p, row_bytes);
+                    p += row_bytes;
+                }
+            }
+            last_frame_number = header.frame_number;
+            return true;
+        }
+
+        const ofPixels_<pix_type> &getPixels() const
+        { return pixels; };
+        // false until first keyframe, or after lost frame
+        bool hasKeyframe() const
+        { return has_keyframe; };
+
+    protected:
+        bool broken() {
+            ofLogWarning("ofxZeroMQPixelsDeltaDecoder") << "broken delta frame";
+            has_keyframe = false;
+            return false;
+        }
+
+        ofPixels_<pix_type> pixels;
+        std::uint64_t last_frame_number{0};
+        bool has_keyframe{false};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQPixelsDeltaEncoder = ofxZeroMQ::PixelsDeltaEncoder<unsigned char>;
+using ofxZeroMQPixelsDeltaDecoder = ofxZeroMQ::PixelsDeltaDecoder<unsigned char>;
+using ofxZeroMQShortPixelsDeltaEncoder = ofxZeroMQ::PixelsDeltaEncoder<unsigned short>;
+using ofxZeroMQShortPixelsDeltaDecoder = ofxZeroMQ::PixelsDeltaDecoder<unsigned short>;
+using ofxZeroMQFloatPixelsDeltaEncoder = ofxZeroMQ::PixelsDeltaEncoder<float>;
+using ofxZeroMQFloatPixelsDeltaDecoder = ofxZeroMQ::PixelsDeltaDecoder<float>;
+
+#endif /* ofxZeroMQPixelsDelta_h */
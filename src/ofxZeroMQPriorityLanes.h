@@ -0,0 +1,206 @@
+//
+//  ofxZeroMQPriorityLanes.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQPriorityLanes_h
+#define ofxZeroMQPriorityLanes_h
+
+#include "ofxZeroMQ.h"
+
+#include <cctype>
+
+// usage:
+//
+// // sender
+// ofxZeroMQPriorityPublisher pub;
+// pub.bind("tcp://*:26666"); // control lane: 26666, bulk lane: 26667
+// pub.sendMultipart(ofxZeroMQ::Lane::Bulk, "video", grabber);
+// pub.sendMultipart(ofxZeroMQ::Lane::Control, "cue", 3);
+//
+// // receiver
+// ofxZeroMQPrioritySubscriber sub;
+// sub.connect("tcp://localhost:26666");
+// ofxZeroMQMultipartMessage m;
+// ofxZeroMQ::Lane lane;
+// while(sub.receiveMultipart(m, lane)) { ... } // control lane is always drained first
+
+namespace ofxZeroMQ {
+    // each lane has own socket, so own pipe and own TCP stream.
+    // large messages on bulk lane never block messages on control lane.
+    enum class Lane : std::uint8_t {
+        Control = 0,
+        Bulk = 1,
+    };
+
+    namespace detail {
+        // port + offset for tcp:// with explicit port, otherwise appends suffix.
+        inline std::string offset_endpoint(const std::string &address,
+                                           int offset,
+                                           const std::string &suffix)
+        {
+            const auto colon = address.rfind(':');
+            const bool is_tcp = address.compare(0, 6, "tcp://") == 0;
+            if(is_tcp && colon != std::string::npos && colon + 1 < address.size()) {
+                const std::string port = address.substr(colon + 1);
+                bool is_numeric = true;
+                for(auto c : port) is_numeric = is_numeric && std::isdigit(static_cast<unsigned char>(c));
+                if(is_numeric) {
+                    return address.substr(0, colon + 1) + std::to_string(std::stoi(port) + offset);
+                }
+            }
+            return address + suffix;
+        }
+
+        // control lane uses given address as is.
+        // bulk lane uses next port for tcp:// with explicit port, otherwise appends ".bulk".
+        inline std::string lane_endpoint(const std::string &address, Lane lane) {
+            if(lane == Lane::Control) return address;
+            return offset_endpoint(address, 1, ".bulk");
+        }
+    }; // detail
+
+#pragma mark - PrioritySender
+    template <typename socket_type>
+    struct PrioritySender {
+        void bind(const std::string &address)
+        { bind(address, detail::lane_endpoint(address, Lane::Bulk)); };
+        void bind(const std::string &control_address,
+                  const std::string &bulk_address)
+        {
+            control.bind(control_address);
+            bulk.bind(bulk_address);
+        }
+
+        void connect(const std::string &address)
+        { connect(address, detail::lane_endpoint(address, Lane::Bulk)); };
+        void connect(const std::string &control_address,
+                     const std::string &bulk_address)
+        {
+            control.connect(control_address);
+            bulk.connect(bulk_address);
+        }
+
+        template <
+            typename type,
+            typename = typename std::enable_if<
+                !std::is_same<typename std::decay<type>::type, MultipartMessage>::value
+            >::type
+        >
+        zmq::send_result_t send(Lane lane,
+                                type &&data,
+                                bool nonblocking = true)
+        { return getSocket(lane).send(std::forward<type>(data), nonblocking); };
+
+        // message is cleared only when sent
+        zmq::send_result_t send(Lane lane,
+                                MultipartMessage &message,
+                                bool nonblocking = true)
+        { return getSocket(lane).send(message, nonblocking); };
+        zmq::send_result_t send(Lane lane,
+                                MultipartMessage &&message,
+                                bool nonblocking = true)
+        { return send(lane, message, nonblocking); };
+
+        template <typename ... types>
+        zmq::send_result_t sendMultipart(Lane lane, types && ... data)
+        { return getSocket(lane).sendMultipart(std::forward<types>(data) ...); };
+
+        // DSCP/TOS value for control lane packets (e.g. 0xB8: expedited forwarding)
+        void setControlTypeOfService(int tos)
+        { control.getRawSocket().setsockopt(ZMQ_TOS, &tos, sizeof(tos)); };
+
+        socket_type &getSocket(Lane lane)
+        { return lane == Lane::Control ? control : bulk; };
+        const socket_type &getSocket(Lane lane) const
+        { return lane == Lane::Control ? control : bulk; };
+
+    protected:
+        socket_type control;
+        socket_type bulk;
+    };
+
+#pragma mark - PriorityReceiver
+    template <typename socket_type>
+    struct PriorityReceiver {
+        PriorityReceiver() {
+            items[0] = {static_cast<void *>(control.getRawSocket()), 0, ZMQ_POLLIN, 0};
+            items[1] = {static_cast<void *>(bulk.getRawSocket()), 0, ZMQ_POLLIN, 0};
+        }
+
+        void bind(const std::string &address)
+        { bind(address, detail::lane_endpoint(address, Lane::Bulk)); };
+        void bind(const std::string &control_address,
+                  const std::string &bulk_address)
+        {
+            control.bind(control_address);
+            bulk.bind(bulk_address);
+        }
+
+        void connect(const std::string &address)
+        { connect(address, detail::lane_endpoint(address, Lane::Bulk)); };
+        void connect(const std::string &control_address,
+                     const std::string &bulk_address)
+        {
+            control.connect(control_address);
+            bulk.connect(bulk_address);
+        }
+
+        // only for Subscriber
+        void addFilter(const std::string &filter) {
+            control.addFilter(filter);
+            bulk.addFilter(filter);
+        }
+        bool removeFilter(const std::string &filter) {
+            bool removed = control.removeFilter(filter);
+            return bulk.removeFilter(filter) || removed;
+        }
+
+        bool hasWaitingMessage(long timeout_millis = 0) {
+            items[0].revents = items[1].revents = 0;
+            return 0 < zmq::poll(items, 2, timeout_millis);
+        }
+
+        // strict priority: bulk lane is read only when control lane is empty.
+        // call repeatedly (e.g. while loop), control messages arrived meanwhile overtake queued bulk messages.
+        bool receiveMultipart(MultipartMessage &message, Lane &lane) {
+            if(control.receiveMultipart(message)) {
+                lane = Lane::Control;
+                return true;
+            }
+            if(bulk.receiveMultipart(message)) {
+                lane = Lane::Bulk;
+                return true;
+            }
+            return false;
+        }
+
+        bool receiveMultipart(MultipartMessage &message) {
+            Lane lane;
+            return receiveMultipart(message, lane);
+        }
+
+        socket_type &getSocket(Lane lane)
+        { return lane == Lane::Control ? control : bulk; };
+        const socket_type &getSocket(Lane lane) const
+        { return lane == Lane::Control ? control : bulk; };
+
+    protected:
+        socket_type control;
+        socket_type bulk;
+        zmq::pollitem_t items[2];
+    };
+
+    using PriorityPublisher = PrioritySender<Publisher>;
+    using PrioritySubscriber = PriorityReceiver<Subscriber>;
+    using PriorityPush = PrioritySender<Push>;
+    using PriorityPull = PriorityReceiver<Pull>;
+}; // ofxZeroMQ
+
+using ofxZeroMQPriorityPublisher = ofxZeroMQ::PriorityPublisher;
+using ofxZeroMQPrioritySubscriber = ofxZeroMQ::PrioritySubscriber;
+using ofxZeroMQPriorityPush = ofxZeroMQ::PriorityPush;
+using ofxZeroMQPriorityPull = ofxZeroMQ::PriorityPull;
+
+#endif /* ofxZeroMQPriorityLanes_h */
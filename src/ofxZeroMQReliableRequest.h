@@ -0,0 +1,206 @@
+//
+//  ofxZeroMQReliableRequest.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQReliableRequest_h
+#define ofxZeroMQReliableRequest_h
+
+#include "ofxZeroMQ.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+// usage:
+//
+// ofxZeroMQReliableRequest client;
+// client.connect("tcp://assets-a:26666"); // primary
+// client.connect("tcp://assets-b:26666"); // failover / hedge target
+// client.setTimeout(200);                 // per attempt
+// client.setRetries(2);
+// client.setHedgingEnabled(true);         // duplicate to next server after p95 latency
+//
+// ofxZeroMQMultipartMessage reply;
+// if(client.request(reply, "lookup", asset_id)) { ... }
+// if(client.requestWithDeadline(50, reply, "lookup", asset_id)) { ... } // whole call including retries
+//
+// servers have to be idempotent for hedged / retried requests.
+
+namespace ofxZeroMQ {
+#pragma mark - ReliableRequest
+    // lazy pirate: REQ socket which didn't get reply in timeout is closed and re-created, then next server is tried.
+    // sockets are ZMQ_REQ_RELAXED | ZMQ_REQ_CORRELATE, so socket which lost hedge race is reused and its late reply is discarded.
+    struct ReliableRequest {
+        // servers are tried in order of connect
+        void connect(const std::string &address) {
+            addresses.push_back(address);
+            sockets.emplace_back();
+            create_socket(sockets.size() - 1);
+        }
+
+        // timeout of each attempt
+        void setTimeout(long timeout_millis)
+        { this->timeout_millis = timeout_millis; };
+        void setRetries(std::size_t retries)
+        { this->retries = retries; };
+
+        // send duplicate to next server if no reply in percentile of recent latencies.
+        // needs 2 or more servers
+        void setHedgingEnabled(bool enabled, float percentile = 0.95f) {
+            is_hedging = enabled;
+            hedge_percentile = std::min(std::max(percentile, 0.0f), 1.0f);
+        }
+        // used until enough latencies are measured
+        void setInitialHedgeDelay(long delay_millis)
+        { initial_hedge_delay_millis = delay_millis; };
+
+        // return false if all attempts failed
+        template <typename ... types>
+        bool request(MultipartMessage &reply, types && ... data)
+        { return requestWithDeadline(timeout_millis * static_cast<long>(retries + 1), reply, std::forward<types>(data) ...); };
+
+        template <typename ... types>
+        bool requestWithDeadline(long deadline_millis, MultipartMessage &reply, types && ... data) {
+            MultipartMessage message{std::forward<types>(data) ...};
+            return request_impl(deadline_millis, reply, message);
+        }
+
+        // percentile of latencies of recent successful requests, in milliseconds
+        float getLatency(float percentile = 0.5f) const {
+            if(latencies.empty()) return 0.0f;
+            std::vector<float> sorted = latencies;
+            const std::size_t n = std::min(sorted.size() - 1, static_cast<std::size_t>(percentile * sorted.size()));
+            std::nth_element(sorted.begin(), sorted.begin() + n, sorted.end());
+            return sorted[n];
+        }
+        float getHedgeDelay() const
+        { return latencies.size() < min_latency_samples ? initial_hedge_delay_millis : getLatency(hedge_percentile); };
+
+        std::uint64_t getNumTimeouts() const
+        { return num_timeouts; };
+        std::uint64_t getNumFailed() const
+        { return num_failed; };
+        std::uint64_t getNumHedged() const
+        { return num_hedged; };
+        // hedged duplicate replied first
+        std::uint64_t getNumHedgeWins() const
+        { return num_hedge_wins; };
+
+    protected:
+        using clock = std::chrono::steady_clock;
+
+        bool request_impl(long deadline_millis, MultipartMessage &reply, MultipartMessage &message) {
+            if(sockets.empty()) {
+                ofLogError("ofxZeroMQReliableRequest") << "no server is connected";
+                return false;
+            }
+            const auto deadline = clock::now() + std::chrono::milliseconds(deadline_millis);
+            for(std::size_t attempt = 0; attempt <= retries && clock::now() < deadline; ++attempt) {
+                const auto begin = clock::now();
+                const auto attempt_deadline = std::min(deadline, begin + std::chrono::milliseconds(timeout_millis));
+                const std::size_t hedge = (primary + 1) % sockets.size();
+                const bool can_hedge = is_hedging && 1 < sockets.size();
+                const auto hedge_time = begin + std::chrono::microseconds(static_cast<long long>(getHedgeDelay() * 1000.0f));
+                bool is_hedged = false;
+
+                if(!send(primary, message)) {
+                    fail_over();
+                    continue;
+                }
+                while(true) {
+                    const auto now = clock::now();
+                    if(attempt_deadline <= now) break;
+                    if(can_hedge && !is_hedged && hedge_time <= now) {
+                        is_hedged = send(hedge, message);
+                        if(is_hedged) ++num_hedged;
+                    }
+                    const auto wait_until = (can_hedge && !is_hedged) ? std::min(hedge_time, attempt_deadline) : attempt_deadline;
+                    const long wait = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(wait_until - now).count());
+
+                    zmq::pollitem_t items[2] = {
+                        { static_cast<void *>(sockets[primary]->getRawSocket()), 0, ZMQ_POLLIN, 0 },
+                        { static_cast<void *>(sockets[hedge]->getRawSocket()), 0, ZMQ_POLLIN, 0 },
+                    };
+                    if(zmq::poll(items, is_hedged ? 2 : 1, std::max(0L, wait)) <= 0) continue;
+                    const bool is_hedge_reply = !(items[0].revents & ZMQ_POLLIN);
+                    if(sockets[is_hedge_reply ? hedge : primary]->receiveMultipart(reply)) {
+                        record(std::chrono::duration<float, std::milli>(clock::now() - begin).count());
+                        if(is_hedge_reply) {
+                            ++num_hedge_wins;
+                            // hedge target is faster now
+                            primary = hedge;
+                        }
+                        return true;
+                    }
+                }
+                ++num_timeouts;
+                ofLogVerbose("ofxZeroMQReliableRequest") << "no reply from " << addresses[primary] << ". retry";
+                if(is_hedged) create_socket(hedge);
+                fail_over();
+            }
+            ++num_failed;
+            return false;
+        }
+
+        bool send(std::size_t index, MultipartMessage &message) {
+            // zmq_msg_copy shares large buffers
+            MultipartMessage copied;
+            for(auto &part : message) {
+                Message shared;
+                shared.copy(part);
+                copied.add(std::move(shared));
+            }
+            return detail::send_multipart(sockets[index]->getRawSocket(), copied, zmq::send_flags::dontwait);
+        }
+
+        // close socket which may be stuck, then try next server
+        void fail_over() {
+            create_socket(primary);
+            primary = (primary + 1) % sockets.size();
+        }
+
+        void create_socket(std::size_t index) {
+            sockets[index].reset(new Request());
+            auto &socket = sockets[index]->getRawSocket();
+            const int linger = 0, enabled = 1;
+            // pending request is discarded on close
+            socket.setsockopt(ZMQ_LINGER, &linger, sizeof(linger));
+            socket.setsockopt(ZMQ_REQ_RELAXED, &enabled, sizeof(enabled));
+            socket.setsockopt(ZMQ_REQ_CORRELATE, &enabled, sizeof(enabled));
+            sockets[index]->connect(addresses[index]);
+        }
+
+        void record(float latency_millis) {
+            if(latencies.size() < max_latency_samples) latencies.push_back(latency_millis);
+            else latencies[next_latency_index] = latency_millis;
+            next_latency_index = (next_latency_index + 1) % max_latency_samples;
+        }
+
+        static constexpr std::size_t max_latency_samples = 128;
+        static constexpr std::size_t min_latency_samples = 16;
+
+        std::vector<std::string> addresses;
+        std::vector<std::unique_ptr<Request>> sockets;
+        std::size_t primary{0};
+
+        long timeout_millis{1000};
+        std::size_t retries{3};
+        bool is_hedging{false};
+        float hedge_percentile{0.95f};
+        long initial_hedge_delay_millis{50};
+
+        std::vector<float> latencies;
+        std::size_t next_latency_index{0};
+
+        std::uint64_t num_timeouts{0};
+        std::uint64_t num_failed{0};
+        std::uint64_t num_hedged{0};
+        std::uint64_t num_hedge_wins{0};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQReliableRequest = ofxZeroMQ::ReliableRequest;
+
+#endif /* ofxZeroMQReliableRequest_h */
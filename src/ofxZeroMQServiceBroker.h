@@ -0,0 +1,448 @@
+//
+//  ofxZeroMQServiceBroker.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQServiceBroker_h
+#define ofxZeroMQServiceBroker_h
+
+#include "ofxZeroMQ.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// usage:
+//
+// // broker (own thread)
+// ofxZeroMQServiceBroker broker;
+// broker.setup("tcp://*:26666");
+//
+// // worker
+// ofxZeroMQServiceWorker worker;
+// worker.setup("tcp://localhost:26666", "render", 2); // accepts 2 requests at once
+// ofxZeroMQServiceRequest request;
+// while(worker.receive(request)) { // call every frame, also sends heartbeat
+//     worker.reply(request, render(request.body[0]));
+// }
+//
+// // client
+// ofxZeroMQServiceClient client;
+// client.connect("tcp://localhost:26666");
+// client.send("render", scene);
+// std::string service;
+// ofxZeroMQMultipartMessage reply;
+// while(client.receive(service, reply)) { ... }
+
+namespace ofxZeroMQ {
+    namespace detail {
+        /* protocol (Majordomo like, all peers connect to one ROUTER):
+         * client -> broker  [Client][service][body ...]
+         * broker -> client  [Client][service][body ...]
+         * worker -> broker  [Ready][service][std::uint32_t capacity]
+         *                   [Reply][client][std::uint64_t request id][body ...]
+         *                   [Heartbeat]
+         *                   [Disconnect]
+         * broker -> worker  [Request][client][std::uint64_t request id][body ...]
+         *                   [Heartbeat]
+         *                   [Disconnect]
+         */
+        enum class service_command : std::uint8_t {
+            Client = 0,
+            Ready = 1,
+            Request = 2,
+            Reply = 3,
+            Heartbeat = 4,
+            Disconnect = 5,
+        };
+
+        struct heartbeat_timer {
+            using clock = std::chrono::steady_clock;
+
+            void setup(long interval_millis, std::size_t liveness) {
+                interval = std::chrono::milliseconds(interval_millis);
+                this->liveness = liveness;
+                const auto now = clock::now();
+                touch(now);
+                sent = now;
+            }
+
+            // peer is alive
+            void touch(clock::time_point now)
+            { expiry = now + interval * liveness; };
+            bool isExpired(clock::time_point now) const
+            { return expiry <= now; };
+
+            // return true if heartbeat should be sent now
+            bool shouldSend(clock::time_point now) {
+                if(now < sent + interval) return false;
+                sent = now;
+                return true;
+            }
+
+            std::chrono::milliseconds interval{1000};
+            std::size_t liveness{3};
+            clock::time_point expiry;
+            clock::time_point sent;
+        };
+    }; // detail
+
+    struct ServiceStatus {
+        std::size_t num_workers{0};
+        // sum of capacities of workers
+        std::size_t capacity{0};
+        std::size_t num_in_flight{0};
+        std::size_t num_queued{0};
+    };
+
+#pragma mark - ServiceBroker
+    // dispatches requests of each service to worker which has lowest in-flight / capacity ratio.
+    // workers not heard from in heartbeat interval * liveness are evicted, and their in-flight requests are dispatched again.
+    struct ServiceBroker {
+        ServiceBroker() {};
+        ServiceBroker(const ServiceBroker &) = delete;
+        ServiceBroker &operator=(const ServiceBroker &) = delete;
+
+        ~ServiceBroker() {
+            is_running = false;
+            if(thread.joinable()) thread.join();
+        }
+
+        // call before setup
+        void setHeartbeat(long interval_millis, std::size_t liveness = 3) {
+            heartbeat_interval_millis = interval_millis;
+            heartbeat_liveness = liveness;
+        }
+
+        void setup(const std::string &address) {
+            router.bind(address);
+            is_running = true;
+            thread = std::thread([this] { process(); });
+        }
+
+        std::map<std::string, ServiceStatus> getServiceStatuses() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::map<std::string, ServiceStatus> statuses;
+            for(const auto &service : services) {
+                ServiceStatus &status = statuses[service.first];
+                status.num_queued = service.second.queue.size();
+                for(const auto &identity : service.second.workers) {
+                    const Worker &worker = workers.at(identity);
+                    ++status.num_workers;
+                    status.capacity += worker.capacity;
+                    status.num_in_flight += worker.in_flight.size();
+                }
+            }
+            return statuses;
+        }
+
+        std::uint64_t getNumEvictedWorkers() const
+        { return num_evicted_workers; };
+
+    protected:
+        struct Request {
+            std::string client;
+            std::string service;
+            MultipartMessage body;
+        };
+        struct Worker {
+            std::string service;
+            std::size_t capacity{1};
+            std::map<std::uint64_t, Request> in_flight;
+            detail::heartbeat_timer timer;
+        };
+        struct Service {
+            std::deque<Request> queue;
+            std::vector<std::string> workers;
+        };
+
+        void process() {
+            while(is_running) {
+                router.hasWaitingMessage(heartbeat_interval_millis);
+                std::lock_guard<std::mutex> lock(mutex);
+                const auto now = std::chrono::steady_clock::now();
+                MultipartMessage m;
+                while(router.receiveMultipart(m)) {
+                    if(m.size() < 2) continue;
+                    const std::string peer = m[0];
+                    const auto command = m[1].get<detail::service_command>();
+                    m.pop();
+                    m.pop();
+                    if(command == detail::service_command::Client) on_client(peer, m);
+                    else on_worker(peer, command, m, now);
+                }
+                evict_expired(now);
+                send_heartbeats(now);
+            }
+        }
+
+        void on_client(const std::string &client, MultipartMessage &m) {
+            if(m.size() < 1) return;
+            Request request;
+            request.client = client;
+            request.service = m.popstr();
+            request.body = std::move(m);
+            Service &service = services[request.service];
+            service.queue.push_back(std::move(request));
+            dispatch(service);
+        }
+
+        void on_worker(const std::string &identity,
+                       detail::service_command command,
+                       MultipartMessage &m,
+                       std::chrono::steady_clock::time_point now)
+        {
+            auto it = workers.find(identity);
+            if(command == detail::service_command::Ready && 2 <= m.size()) {
+                if(it != workers.end()) {
+                    // protocol error. worker has to say ready only once
+                    remove_worker(identity);
+                    router.sendMultipart(identity, detail::service_command::Disconnect);
+                    return;
+                }
+                Worker &worker = workers[identity];
+                worker.service = m[0].get<std::string>();
+                worker.capacity = std::max<std::uint32_t>(1, m[1].get<std::uint32_t>());
+                worker.timer.setup(heartbeat_interval_millis, heartbeat_liveness);
+                Service &service = services[worker.service];
+                service.workers.push_back(identity);
+                dispatch(service);
+                return;
+            }
+            if(it == workers.end()) {
+                // e.g. evicted worker came back. it has to reconnect and say ready again
+                if(command != detail::service_command::Disconnect) router.sendMultipart(identity, detail::service_command::Disconnect);
+                return;
+            }
+            Worker &worker = it->second;
+            worker.timer.touch(now);
+            if(command == detail::service_command::Reply && 2 <= m.size()) {
+                const std::string client = m.popstr();
+                const std::uint64_t id = m[0];
+                m.pop();
+                if(worker.in_flight.erase(id) == 0) return;
+                MultipartMessage reply;
+                reply.addArgument(client);
+                reply.addArgument(detail::service_command::Client);
+                reply.addArgument(worker.service);
+                while(!m.empty()) reply.add(m.pop());
+                router.sendMultipart(std::move(reply));
+                dispatch(services[worker.service]);
+            } else if(command == detail::service_command::Disconnect) {
+                remove_worker(identity);
+            }
+        }
+
+        void dispatch(Service &service) {
+            while(!service.queue.empty()) {
+                // least loaded worker which has free capacity
+                Worker *target = nullptr;
+                const std::string *target_identity = nullptr;
+                for(const auto &identity : service.workers) {
+                    Worker &worker = workers.at(identity);
+                    if(worker.capacity <= worker.in_flight.size()) continue;
+                    if(!target || worker.in_flight.size() * target->capacity < target->in_flight.size() * worker.capacity) {
+                        target = &worker;
+                        target_identity = &identity;
+                    }
+                }
+                if(!target) return;
+
+                Request &request = service.queue.front();
+                const std::uint64_t id = next_request_id++;
+                MultipartMessage m;
+                m.addArgument(*target_identity);
+                m.addArgument(detail::service_command::Request);
+                m.addArgument(request.client);
+                m.addArgument(id);
+                // keep body to dispatch again if worker dies. zmq_msg_copy shares large buffers
+                for(auto &part : request.body) {
+                    Message shared;
+                    shared.copy(part);
+                    m.add(std::move(shared));
+                }
+                router.sendMultipart(std::move(m));
+                target->in_flight.emplace(id, std::move(request));
+                service.queue.pop_front();
+            }
+        }
+
+        void remove_worker(const std::string &identity) {
+            auto it = workers.find(identity);
+            if(it == workers.end()) return;
+            Service &service = services[it->second.service];
+            service.workers.erase(std::remove(service.workers.begin(), service.workers.end(), identity), service.workers.end());
+            // requests are not lost with worker. dispatched again in order
+            for(auto r = it->second.in_flight.rbegin(); r != it->second.in_flight.rend(); ++r) {
+                service.queue.push_front(std::move(r->second));
+            }
+            workers.erase(it);
+            dispatch(service);
+        }
+
+        void evict_expired(std::chrono::steady_clock::time_point now) {
+            std::vector<std::string> expired;
+            for(const auto &worker : workers) {
+                if(worker.second.timer.isExpired(now)) expired.push_back(worker.first);
+            }
+            for(const auto &identity : expired) {
+                ofLogWarning("ofxZeroMQServiceBroker") << "worker of " << workers.at(identity).service << " is evicted by heartbeat timeout";
+                ++num_evicted_workers;
+                remove_worker(identity);
+            }
+        }
+
+        void send_heartbeats(std::chrono::steady_clock::time_point now) {
+            for(auto &worker : workers) {
+                if(worker.second.timer.shouldSend(now)) router.sendMultipart(worker.first, detail::service_command::Heartbeat);
+            }
+        }
+
+        Router router;
+        std::thread thread;
+        std::atomic_bool is_running{false};
+
+        mutable std::mutex mutex;
+        std::map<std::string, Worker> workers;
+        std::map<std::string, Service> services;
+        std::uint64_t next_request_id{0};
+        std::atomic<std::uint64_t> num_evicted_workers{0};
+
+        long heartbeat_interval_millis{250};
+        std::size_t heartbeat_liveness{3};
+    };
+
+#pragma mark - ServiceWorker
+    struct ServiceRequest {
+        std::string client;
+        std::uint64_t id;
+        MultipartMessage body;
+    };
+
+    struct ServiceWorker {
+        ~ServiceWorker() {
+            if(!address.empty()) dealer.sendMultipart(detail::service_command::Disconnect);
+        }
+
+        // call before setup. has to be same as broker
+        void setHeartbeat(long interval_millis, std::size_t liveness = 3) {
+            heartbeat_interval_millis = interval_millis;
+            heartbeat_liveness = liveness;
+        }
+
+        // capacity is number of requests which this worker processes at once
+        void setup(const std::string &address,
+                   const std::string &service,
+                   std::uint32_t capacity = 1)
+        {
+            this->address = address;
+            this->service = service;
+            this->capacity = capacity;
+            connect();
+        }
+
+        // call every frame, even if busy. otherwise this worker is evicted by broker.
+        // return true if request is received
+        bool receive(ServiceRequest &request) {
+            const auto now = std::chrono::steady_clock::now();
+            if(timer.shouldSend(now)) dealer.sendMultipart(detail::service_command::Heartbeat);
+            MultipartMessage m;
+            while(dealer.receiveMultipart(m)) {
+                timer.touch(now);
+                if(m.size() < 1) continue;
+                const auto command = m[0].get<detail::service_command>();
+                if(command == detail::service_command::Request && 3 <= m.size()) {
+                    m.pop();
+                    request.client = m.popstr();
+                    request.id = m[0];
+                    m.pop();
+                    request.body = std::move(m);
+                    return true;
+                } else if(command == detail::service_command::Disconnect) {
+                    reconnect();
+                    return false;
+                }
+            }
+            if(timer.isExpired(now)) {
+                ofLogWarning("ofxZeroMQServiceWorker") << "broker is not responding. reconnect";
+                reconnect();
+            }
+            return false;
+        }
+
+        template <typename ... types>
+        bool reply(const ServiceRequest &request, types && ... body) {
+            return dealer.sendMultipart(detail::service_command::Reply,
+                                        request.client,
+                                        request.id,
+                                        std::forward<types>(body) ...).has_value();
+        }
+
+    protected:
+        void connect() {
+            dealer.connect(address);
+            dealer.sendMultipart(detail::service_command::Ready, service, capacity);
+            timer.setup(heartbeat_interval_millis, heartbeat_liveness);
+        }
+
+        void reconnect() {
+            dealer.disconnect(address);
+            connect();
+        }
+
+        Dealer dealer;
+        std::string address;
+        std::string service;
+        std::uint32_t capacity{1};
+        detail::heartbeat_timer timer;
+        long heartbeat_interval_millis{250};
+        std::size_t heartbeat_liveness{3};
+    };
+
+#pragma mark - ServiceClient
+    struct ServiceClient {
+        void connect(const std::string &address)
+        { dealer.connect(address); };
+        void disconnect(const std::string &address)
+        { dealer.disconnect(address); };
+
+        // requests are pipelined. replies are received in order of completion
+        template <typename ... types>
+        bool send(const std::string &service, types && ... body) {
+            return dealer.sendMultipart(detail::service_command::Client,
+                                        service,
+                                        std::forward<types>(body) ...).has_value();
+        }
+
+        // return false if no reply
+        bool receive(std::string &service, MultipartMessage &reply) {
+            MultipartMessage m;
+            while(dealer.receiveMultipart(m)) {
+                if(m.size() < 2 || m[0].get<detail::service_command>() != detail::service_command::Client) continue;
+                m.pop();
+                service = m.popstr();
+                reply = std::move(m);
+                return true;
+            }
+            return false;
+        }
+
+        bool hasWaitingMessage(long timeout_millis = 0)
+        { return dealer.hasWaitingMessage(timeout_millis); };
+
+    protected:
+        Dealer dealer;
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQServiceBroker = ofxZeroMQ::ServiceBroker;
+using ofxZeroMQServiceWorker = ofxZeroMQ::ServiceWorker;
+using ofxZeroMQServiceClient = ofxZeroMQ::ServiceClient;
+using ofxZeroMQServiceRequest = ofxZeroMQ::ServiceRequest;
+using ofxZeroMQServiceStatus = ofxZeroMQ::ServiceStatus;
+
+#endif /* ofxZeroMQServiceBroker_h */
@@ -0,0 +1,193 @@
+//
+//  ofxZeroMQSharding.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQSharding_h
+#define ofxZeroMQSharding_h
+
+#include "ofxZeroMQ.h"
+#include "ofxZeroMQPriorityLanes.h"
+
+#include <memory>
+
+// usage:
+//
+// // sender
+// ofxZeroMQShardedPublisher pub{4};
+// pub.bind("tcp://*:26666"); // shard i binds 26666 + i
+// pub.sendMultipart("camera/1", pixels); // sent from shard of "camera/1"
+//
+// // receiver
+// ofxZeroMQShardedSubscriber sub{4}; // same number of shards as publisher
+// sub.connect("tcp://localhost:26666");
+// sub.addFilter("camera/1"); // subscribes only shard of "camera/1". meant for exact topic, see addFilter
+// ofxZeroMQMultipartMessage m;
+// while(sub.receiveMultipart(m)) { ... }
+
+namespace ofxZeroMQ {
+    namespace detail {
+        // FNV-1a. stable across platforms, both sides have to agree
+        inline std::size_t topic_shard(const void *topic, std::size_t size, std::size_t num_shards) {
+            const unsigned char *p = static_cast<const unsigned char *>(topic);
+            std::uint32_t hash = 2166136261u;
+            for(std::size_t i = 0; i < size; ++i) {
+                hash ^= p[i];
+                hash *= 16777619u;
+            }
+            return hash % num_shards;
+        }
+
+        inline std::size_t topic_shard(const std::string &topic, std::size_t num_shards)
+        { return topic_shard(topic.data(), topic.size(), num_shards); };
+
+        // shard 0 uses given address as is.
+        inline std::string shard_endpoint(const std::string &address, std::size_t shard) {
+            if(shard == 0) return address;
+            return offset_endpoint(address, static_cast<int>(shard), "." + std::to_string(shard));
+        }
+    }; // detail
+
+#pragma mark - ShardedPublisher
+    // each shard is own PUB socket pinned to one I/O thread by ZMQ_AFFINITY,
+    // so encoding / TCP work of fan-out is spread over I/O threads of context.
+    // topic (first part of message) is hashed to choose shard.
+    struct ShardedPublisher {
+        ShardedPublisher(std::size_t num_shards = 4) {
+            const int num_io_threads = std::max(1, Socket::getContext().getctxopt(ZMQ_IO_THREADS));
+            for(std::size_t i = 0; i < std::max<std::size_t>(1, num_shards); ++i) {
+                shards.emplace_back(new Publisher());
+                // affinity has to be set before bind / connect
+                const std::uint64_t affinity = 1ULL << (i % num_io_threads);
+                shards.back()->getRawSocket().setsockopt(ZMQ_AFFINITY, &affinity, sizeof(affinity));
+            }
+        }
+
+        void bind(const std::string &address) {
+            for(std::size_t i = 0; i < shards.size(); ++i) {
+                shards[i]->bind(detail::shard_endpoint(address, i));
+            }
+        }
+        void unbind(const std::string &address) {
+            for(std::size_t i = 0; i < shards.size(); ++i) {
+                shards[i]->unbind(detail::shard_endpoint(address, i));
+            }
+        }
+
+        // for xpub-xsub pattern
+        void connect(const std::string &address) {
+            for(std::size_t i = 0; i < shards.size(); ++i) {
+                shards[i]->connect(detail::shard_endpoint(address, i));
+            }
+        }
+        void disconnect(const std::string &address) {
+            for(std::size_t i = 0; i < shards.size(); ++i) {
+                shards[i]->disconnect(detail::shard_endpoint(address, i));
+            }
+        }
+
+        // first part is topic
+        zmq::send_result_t send(MultipartMessage &message) {
+            if(message.empty()) return {};
+            const zmq::message_t &topic = message.at(0);
+            return shards[detail::topic_shard(topic.data(), topic.size(), shards.size())]->send(message);
+        }
+
+        template <typename ... types>
+        zmq::send_result_t sendMultipart(const std::string &topic, types && ... data)
+        { return getShard(topic).sendMultipart(topic, std::forward<types>(data) ...); };
+
+        // each shard can be used from own thread. e.g. one encoder thread per shard
+        Publisher &getShard(const std::string &topic)
+        { return *shards[detail::topic_shard(topic, shards.size())]; };
+        Publisher &getShard(std::size_t index)
+        { return *shards[index]; };
+        std::size_t getNumShards() const
+        { return shards.size(); };
+
+        void setTracingEnabled(bool enabled)
+        { for(auto &shard : shards) shard->setTracingEnabled(enabled); };
+
+    protected:
+        std::vector<std::unique_ptr<Publisher>> shards;
+    };
+
+#pragma mark - ShardedSubscriber
+    struct ShardedSubscriber {
+        ShardedSubscriber(std::size_t num_shards = 4) {
+            for(std::size_t i = 0; i < std::max<std::size_t>(1, num_shards); ++i) {
+                shards.emplace_back(new Subscriber());
+            }
+        }
+
+        // connect of raw sockets, because Subscriber::connect subscribes everything if no filter is added yet.
+        // so shards without filter receive nothing, and filters can be added before or after connect
+        void connect(const std::string &address) {
+            for(std::size_t i = 0; i < shards.size(); ++i) {
+                shards[i]->getRawSocket().connect(detail::shard_endpoint(address, i));
+            }
+        }
+        void disconnect(const std::string &address) {
+            for(std::size_t i = 0; i < shards.size(); ++i) {
+                shards[i]->disconnect(detail::shard_endpoint(address, i));
+            }
+        }
+
+        // topic is hashed as whole, so filter subscribes only shard of its own string.
+        // so it is not reliable prefix: "camera/1" receives "camera/10" only if it happens to be on same shard.
+        // use addPrefixFilter for prefix match. empty filter subscribes all shards.
+        void addFilter(const std::string &filter) {
+            if(filter.empty()) addPrefixFilter(filter);
+            else getShard(filter).addFilter(filter);
+        }
+        bool removeFilter(const std::string &filter) {
+            if(filter.empty()) return removePrefixFilter(filter);
+            return getShard(filter).removeFilter(filter);
+        }
+
+        // prefix matches topics on any shard
+        void addPrefixFilter(const std::string &prefix)
+        { for(auto &shard : shards) shard->addFilter(prefix); };
+        bool removePrefixFilter(const std::string &prefix) {
+            bool removed = false;
+            for(auto &shard : shards) removed = shard->removeFilter(prefix) || removed;
+            return removed;
+        }
+
+        bool hasWaitingMessage(long timeout_millis = 0) {
+            std::vector<zmq::pollitem_t> items;
+            items.reserve(shards.size());
+            for(auto &shard : shards) {
+                items.push_back({static_cast<void *>(shard->getRawSocket()), 0, ZMQ_POLLIN, 0});
+            }
+            return 0 < zmq::poll(items.data(), items.size(), timeout_millis);
+        }
+
+        // shards are read in round robin, so one busy shard doesn't starve others
+        bool receiveMultipart(MultipartMessage &message) {
+            for(std::size_t i = 0; i < shards.size(); ++i) {
+                Subscriber &shard = *shards[next_shard];
+                next_shard = (next_shard + 1) % shards.size();
+                if(shard.receiveMultipart(message)) return true;
+            }
+            return false;
+        }
+
+        Subscriber &getShard(const std::string &topic)
+        { return *shards[detail::topic_shard(topic, shards.size())]; };
+        Subscriber &getShard(std::size_t index)
+        { return *shards[index]; };
+        std::size_t getNumShards() const
+        { return shards.size(); };
+
+    protected:
+        std::vector<std::unique_ptr<Subscriber>> shards;
+        std::size_t next_shard{0};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQShardedPublisher = ofxZeroMQ::ShardedPublisher;
+using ofxZeroMQShardedSubscriber = ofxZeroMQ::ShardedSubscriber;
+
+#endif /* ofxZeroMQSharding_h */
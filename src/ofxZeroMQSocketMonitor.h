@@ -0,0 +1,244 @@
+//
+//  ofxZeroMQSocketMonitor.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQSocketMonitor_h
+#define ofxZeroMQSocketMonitor_h
+
+#include "ofxZeroMQ.h"
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <sstream>
+
+#include "ofEvents.h"
+
+/* usage:
+ *
+ * ofxZeroMQSubscriber sub;
+ * ofxZeroMQSocketMonitor monitor; // declare after sub. monitor has to be destroyed before sub
+ *
+ * monitor.setup(sub);
+ * ofAddListener(monitor.disconnected, this, &ofApp::onDisconnected);
+ * sub.connect("tcp://localhost:26666");
+ *
+ * NOTE: events are notified on monitor thread.
+ */
+
+namespace ofxZeroMQ {
+    struct SocketMonitorEvent {
+        // ZMQ_EVENT_*
+        std::uint16_t event{0};
+        // fd, errno or reconnect interval (depends on event)
+        std::uint32_t value{0};
+        std::string endpoint;
+        // nanoseconds from connected / accepted to handshake succeeded. only for ZMQ_EVENT_HANDSHAKE_SUCCEEDED
+        std::int64_t handshake_nanos{0};
+    };
+
+    // state per endpoint. on bound socket, all peers accepted by a listener share its endpoint
+    struct EndpointState {
+        // true while num_connections is not 0
+        bool is_connected{false};
+        // connections which succeeded handshake and are not disconnected yet
+        std::uint32_t num_connections{0};
+        std::uint64_t num_connected{0};
+        std::uint64_t num_disconnected{0};
+        std::uint64_t num_connect_retried{0};
+        std::uint64_t num_handshake_failed{0};
+        std::int64_t last_handshake_nanos{0};
+        // latest ZMQ_EVENT_*
+        std::uint16_t last_event{0};
+        std::int64_t last_event_time{0};
+    };
+
+    struct SocketMonitor {
+        SocketMonitor() {};
+        SocketMonitor(const SocketMonitor &) = delete;
+        SocketMonitor &operator=(const SocketMonitor &) = delete;
+
+        virtual ~SocketMonitor()
+        { stop(); };
+
+        // call before connect / bind to observe all events.
+        void setup(Socket &socket, int events = ZMQ_EVENT_ALL) {
+            stop();
+            this->socket = &socket;
+            std::ostringstream ss;
+            ss << "inproc://ofxZeroMQ.SocketMonitor." << static_cast<const void *>(this);
+            address = ss.str();
+
+            int rc = zmq_socket_monitor(static_cast<void *>(socket.getRawSocket()), address.c_str(), events);
+            if(rc != 0) {
+                ofLogError("ofxZeroMQSocketMonitor::setup") << "zmq_socket_monitor failed: " << zmq_strerror(zmq_errno());
+                this->socket = nullptr;
+                return;
+            }
+
+            // PAIR has to be connected before events are dropped. monitor socket is bound already.
+            pair.reset(new zmq::socket_t(Socket::getContext(), ZMQ_PAIR));
+            pair->connect(address.c_str());
+            is_running = true;
+            thread = std::thread([this] { process(); });
+        }
+
+        // called by destructor. monitored socket has to be alive.
+        void stop() {
+            if(socket == nullptr) return;
+            zmq_socket_monitor(static_cast<void *>(socket->getRawSocket()), nullptr, 0);
+            is_running = false;
+            if(thread.joinable()) thread.join();
+            pair.reset();
+            socket = nullptr;
+        }
+
+        bool isConnected() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(const auto &pair : states) if(pair.second.is_connected) return true;
+            return false;
+        }
+
+        std::map<std::string, EndpointState> getEndpointStates() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return states;
+        }
+
+        EndpointState getEndpointState(const std::string &endpoint) const {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = states.find(endpoint);
+            return it == states.end() ? EndpointState{} : it->second;
+        }
+
+        // all events
+        ofEvent<SocketMonitorEvent> eventReceived;
+        // handshake succeeded. i.e. peer is ready to exchange messages
+        ofEvent<SocketMonitorEvent> connected;
+        ofEvent<SocketMonitorEvent> disconnected;
+        ofEvent<SocketMonitorEvent> connectRetried;
+        ofEvent<SocketMonitorEvent> handshakeFailed;
+
+    protected:
+        void process() {
+            zmq::pollitem_t item{static_cast<void *>(*pair), 0, ZMQ_POLLIN, 0};
+            while(is_running) {
+                if(zmq::poll(&item, 1, 100) <= 0) continue;
+                zmq::multipart_t message;
+                try {
+                    if(!message.recv(*pair, ZMQ_DONTWAIT)) continue;
+                } catch(const zmq::error_t &e) {
+                    break;
+                }
+                if(message.size() < 2 || message[0].size() < sizeof(std::uint16_t) + sizeof(std::uint32_t)) continue;
+
+                SocketMonitorEvent event;
+                const char *data = static_cast<const char *>(message[0].data());
+                std::memcpy(&event.event, data, sizeof(event.event));
+                std::memcpy(&event.value, data + sizeof(event.event), sizeof(event.value));
+                event.endpoint = std::string{static_cast<const char *>(message[1].data()), message[1].size()};
+                if(event.event == ZMQ_EVENT_MONITOR_STOPPED) break;
+
+                update_state(event);
+                notify(event);
+            }
+        }
+
+        // connections are tracked by fd (value of CONNECTED / ACCEPTED / DISCONNECTED).
+        // HANDSHAKE_SUCCEEDED has no fd, so it is matched with oldest connection waiting handshake on same endpoint.
+        void update_state(SocketMonitorEvent &event) {
+            const std::int64_t now = detail::now_nanos();
+            std::lock_guard<std::mutex> lock(mutex);
+            EndpointState &state = states[event.endpoint];
+            Connections &conns = connections[event.endpoint];
+            switch(event.event) {
+                case ZMQ_EVENT_CONNECTED:
+                case ZMQ_EVENT_ACCEPTED:
+                    conns.handshaking[event.value] = now;
+                    break;
+                case ZMQ_EVENT_HANDSHAKE_SUCCEEDED: {
+                    ++state.num_connected;
+                    auto oldest = conns.handshaking.end();
+                    for(auto it = conns.handshaking.begin(); it != conns.handshaking.end(); ++it) {
+                        if(oldest == conns.handshaking.end() || it->second < oldest->second) oldest = it;
+                    }
+                    if(oldest != conns.handshaking.end()) {
+                        event.handshake_nanos = now - oldest->second;
+                        state.last_handshake_nanos = event.handshake_nanos;
+                        conns.established.insert(oldest->first);
+                        conns.handshaking.erase(oldest);
+                        // counted only with fd, so following DISCONNECTED can decrease it
+                        ++state.num_connections;
+                    }
+                    break;
+                }
+                case ZMQ_EVENT_DISCONNECTED:
+                    if(0 < conns.established.erase(event.value) && 0 < state.num_connections) {
+                        --state.num_connections;
+                        ++state.num_disconnected;
+                    }
+                    conns.handshaking.erase(event.value);
+                    break;
+                case ZMQ_EVENT_CONNECT_RETRIED:
+                    ++state.num_connect_retried;
+                    break;
+                case ZMQ_EVENT_HANDSHAKE_FAILED_NO_DETAIL:
+                case ZMQ_EVENT_HANDSHAKE_FAILED_PROTOCOL:
+                case ZMQ_EVENT_HANDSHAKE_FAILED_AUTH:
+                    // connection is removed by following DISCONNECTED
+                    ++state.num_handshake_failed;
+                    break;
+                default:
+                    break;
+            }
+            state.is_connected = 0 < state.num_connections;
+            state.last_event = event.event;
+            state.last_event_time = now;
+        }
+
+        void notify(SocketMonitorEvent &event) {
+            ofNotifyEvent(eventReceived, event, this);
+            switch(event.event) {
+                case ZMQ_EVENT_HANDSHAKE_SUCCEEDED:
+                    ofNotifyEvent(connected, event, this);
+                    break;
+                case ZMQ_EVENT_DISCONNECTED:
+                    ofNotifyEvent(disconnected, event, this);
+                    break;
+                case ZMQ_EVENT_CONNECT_RETRIED:
+                    ofNotifyEvent(connectRetried, event, this);
+                    break;
+                case ZMQ_EVENT_HANDSHAKE_FAILED_NO_DETAIL:
+                case ZMQ_EVENT_HANDSHAKE_FAILED_PROTOCOL:
+                case ZMQ_EVENT_HANDSHAKE_FAILED_AUTH:
+                    ofNotifyEvent(handshakeFailed, event, this);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        Socket *socket{nullptr};
+        std::string address;
+        std::unique_ptr<zmq::socket_t> pair;
+        std::thread thread;
+        std::atomic_bool is_running{false};
+
+        mutable std::mutex mutex;
+        std::map<std::string, EndpointState> states;
+        struct Connections {
+            // fd -> time of transport connected
+            std::map<std::uint32_t, std::int64_t> handshaking;
+            std::set<std::uint32_t> established;
+        };
+        std::map<std::string, Connections> connections;
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQSocketMonitor = ofxZeroMQ::SocketMonitor;
+using ofxZeroMQSocketMonitorEvent = ofxZeroMQ::SocketMonitorEvent;
+
+#endif /* ofxZeroMQSocketMonitor_h */
@@ -0,0 +1,308 @@
+//
+//  ofxZeroMQSpool.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQSpool_h
+#define ofxZeroMQSpool_h
+
+#include "ofxZeroMQ.h"
+#include "detail/ofxZeroMQMappedFile.h"
+
+#include <deque>
+#include <iomanip>
+#include <sstream>
+
+#include "ofFileUtils.h"
+
+// usage:
+//
+// ofxZeroMQSpoolingPush push;
+// push.setup("spool"); // relative to data path
+// push.connect("tcp://worker:26666");
+//
+// push.sendMultipart("frame", data); // never blocks. spooled to disk when HWM is reached
+// push.update(); // call every frame. sends spooled messages in order when peer catches up
+
+namespace ofxZeroMQ {
+    namespace detail {
+        /* spool segment file:
+         * header
+         *   std::uint64_t magic
+         *   std::uint64_t write_end // end of written records
+         *   std::uint64_t read_pos  // next record to send
+         *   std::uint64_t reserved
+         * records
+         *   std::uint32_t num_parts
+         *   { std::uint32_t size, bytes[size] } * num_parts
+         */
+        static constexpr std::uint64_t spool_magic = 0x6C6F6F70737A666FULL; // "ofzspool"
+        static constexpr std::size_t spool_header_size = sizeof(std::uint64_t) * 4;
+    }; // detail
+
+#pragma mark - DiskSpool
+    // FIFO of multipart messages in memory mapped append-only segment files.
+    // memory usage is bounded by OS page cache. drained segments are removed.
+    // undrained messages are recovered by setup with same directory.
+    struct DiskSpool {
+        DiskSpool() {};
+        DiskSpool(const DiskSpool &) = delete;
+        DiskSpool &operator=(const DiskSpool &) = delete;
+
+        bool setup(const std::string &directory,
+                   std::size_t segment_size = 64 * 1024 * 1024)
+        {
+            segments.clear();
+            num_messages = 0;
+            num_bytes = 0;
+            this->directory = ofToDataPath(directory, true);
+            this->segment_size = segment_size;
+            if(!ofDirectory::doesDirectoryExist(this->directory, false)) {
+                if(!ofDirectory::createDirectory(this->directory, false, true)) {
+                    ofLogError("ofxZeroMQDiskSpool::setup") << "can't create directory " << this->directory;
+                    return false;
+                }
+            }
+            recover();
+            return true;
+        }
+
+        bool push(const zmq::multipart_t &message) {
+            std::size_t record_size = sizeof(std::uint32_t);
+            for(const auto &part : message) record_size += sizeof(std::uint32_t) + part.size();
+
+            if(segments.empty() || segments.back().file.size() < segments.back().write_end() + record_size) {
+                if(!open_segment(next_index, std::max(segment_size, detail::spool_header_size + record_size), true)) return false;
+                ++next_index;
+                // drained segment reset in place may be left before new one
+                remove_drained_segments();
+            }
+
+            Segment &segment = segments.back();
+            char *p = segment.file.data() + segment.write_end();
+            detail::write_u32(p, static_cast<std::uint32_t>(message.size()));
+            p += sizeof(std::uint32_t);
+            for(const auto &part : message) {
+                detail::write_u32(p, static_cast<std::uint32_t>(part.size()));
+                p += sizeof(std::uint32_t);
+                std::memcpy(p, part.data(), part.size());
+                p += part.size();
+            }
+            segment.set_write_end(segment.write_end() + record_size);
+
+            ++num_messages;
+            num_bytes += record_size;
+            return true;
+        }
+
+        // copy oldest message. return false if empty
+        bool front(zmq::multipart_t &message) const {
+            message.clear();
+            if(empty()) return false;
+            const Segment &segment = segments.front();
+            const char *p = segment.file.data() + segment.read_pos();
+            const std::uint32_t num_parts = detail::read_u32(p);
+            p += sizeof(std::uint32_t);
+            for(std::uint32_t i = 0; i < num_parts; ++i) {
+                const std::uint32_t size = detail::read_u32(p);
+                p += sizeof(std::uint32_t);
+                message.addmem(p, size);
+                p += size;
+            }
+            return true;
+        }
+
+        void pop() {
+            if(empty()) return;
+            Segment &segment = segments.front();
+            const std::uint64_t record_size = segment.record_size_at(segment.read_pos());
+            segment.set_read_pos(segment.read_pos() + record_size);
+            --num_messages;
+            num_bytes -= record_size;
+
+            if(!segment.is_drained()) return;
+            if(segments.size() == 1) {
+                // reuse last segment
+                segment.set_read_pos(detail::spool_header_size);
+                segment.set_write_end(detail::spool_header_size);
+            } else {
+                const std::string path = segment.path;
+                segments.pop_front();
+                ofFile::removeFile(path, false);
+            }
+        }
+
+        bool empty() const
+        { return num_messages == 0; };
+        std::uint64_t getNumMessages() const
+        { return num_messages; };
+        std::uint64_t getNumBytes() const
+        { return num_bytes; };
+
+    protected:
+        struct Segment {
+            std::string path;
+            detail::mapped_file file;
+
+            bool is_drained() const
+            { return write_end() <= read_pos(); };
+
+            std::uint64_t write_end() const
+            { return detail::read_u64(file.data() + sizeof(std::uint64_t)); };
+            void set_write_end(std::uint64_t v)
+            { detail::write_u64(file.data() + sizeof(std::uint64_t), v); };
+            std::uint64_t read_pos() const
+            { return detail::read_u64(file.data() + sizeof(std::uint64_t) * 2); };
+            void set_read_pos(std::uint64_t v)
+            { detail::write_u64(file.data() + sizeof(std::uint64_t) * 2, v); };
+
+            std::uint64_t record_size_at(std::uint64_t pos) const {
+                const char *p = file.data() + pos;
+                const std::uint32_t num_parts = detail::read_u32(p);
+                std::uint64_t size = sizeof(std::uint32_t);
+                for(std::uint32_t i = 0; i < num_parts; ++i) {
+                    size += sizeof(std::uint32_t) + detail::read_u32(p + size);
+                }
+                return size;
+            }
+        };
+
+        std::string segment_path(std::uint64_t index) const {
+            std::ostringstream ss;
+            ss << std::setw(10) << std::setfill('0') << index << ".spool";
+            return ofFilePath::join(directory, ss.str());
+        }
+
+        bool open_segment(std::uint64_t index, std::size_t size, bool create) {
+            Segment segment;
+            segment.path = segment_path(index);
+            if(!segment.file.open(segment.path, create ? size : 0)) return false;
+            if(create) {
+                detail::write_u64(segment.file.data(), detail::spool_magic);
+                segment.set_write_end(detail::spool_header_size);
+                segment.set_read_pos(detail::spool_header_size);
+            } else if(segment.file.size() < detail::spool_header_size
+                      || detail::read_u64(segment.file.data()) != detail::spool_magic)
+            {
+                ofLogWarning("ofxZeroMQDiskSpool") << "ignore broken segment " << segment.path;
+                return false;
+            }
+            segments.push_back(std::move(segment));
+            return true;
+        }
+
+        // keep front segment readable. last one is kept for reuse
+        void remove_drained_segments() {
+            while(1 < segments.size() && segments.front().is_drained()) {
+                const std::string path = segments.front().path;
+                segments.pop_front();
+                ofFile::removeFile(path, false);
+            }
+        }
+
+        void recover() {
+            ofDirectory dir(directory);
+            dir.allowExt("spool");
+            dir.listDir();
+            dir.sort();
+            next_index = 0;
+            for(std::size_t i = 0; i < dir.size(); ++i) {
+                const std::string name = ofFilePath::getBaseName(dir.getPath(i));
+                const std::uint64_t index = std::strtoull(name.c_str(), nullptr, 10);
+                if(!open_segment(index, 0, false)) continue;
+                next_index = index + 1;
+                const Segment &segment = segments.back();
+                for(std::uint64_t pos = segment.read_pos(); pos < segment.write_end(); ) {
+                    const std::uint64_t size = segment.record_size_at(pos);
+                    pos += size;
+                    num_bytes += size;
+                    ++num_messages;
+                }
+            }
+            remove_drained_segments();
+            if(0 < num_messages) {
+                ofLogNotice("ofxZeroMQDiskSpool") << "recovered " << num_messages << " spooled messages from " << directory;
+            }
+        }
+
+        std::deque<Segment> segments;
+        std::string directory;
+        std::size_t segment_size{64 * 1024 * 1024};
+        std::uint64_t next_index{0};
+        std::uint64_t num_messages{0};
+        std::uint64_t num_bytes{0};
+    };
+
+#pragma mark - SpoolingPush
+    struct SpoolingPush {
+        bool setup(const std::string &spool_directory,
+                   std::size_t segment_size = 64 * 1024 * 1024)
+        { return spool.setup(spool_directory, segment_size); };
+
+        void bind(const std::string &address)
+        { push.bind(address); };
+        void unbind(const std::string &address)
+        { push.unbind(address); };
+        void connect(const std::string &address)
+        { push.connect(address); };
+        void disconnect(const std::string &address)
+        { push.disconnect(address); };
+
+        // return false only when message can't be spooled
+        bool send(MultipartMessage &message) {
+            update();
+            if(spool.empty() && push.send(message)) return true;
+            return spool.push(message);
+        }
+
+        template <
+            typename type,
+            typename = typename std::enable_if<
+                !std::is_same<typename std::decay<type>::type, MultipartMessage>::value
+            >::type
+        >
+        bool send(type &&data) {
+            MultipartMessage message;
+            message.addArgument(std::forward<type>(data));
+            return send(message);
+        }
+
+        template <typename ... types>
+        bool sendMultipart(types && ... data) {
+            MultipartMessage message{std::forward<types>(data) ...};
+            return send(message);
+        }
+
+        // send spooled messages in order until HWM is reached again. return number of sent messages
+        std::size_t update() {
+            std::size_t num_sent = 0;
+            MultipartMessage message;
+            while(spool.front(message)) {
+                if(!push.send(message)) break;
+                spool.pop();
+                ++num_sent;
+            }
+            return num_sent;
+        }
+
+        std::uint64_t getNumSpooledMessages() const
+        { return spool.getNumMessages(); };
+        std::uint64_t getNumSpooledBytes() const
+        { return spool.getNumBytes(); };
+
+        Push &getPush()
+        { return push; };
+        DiskSpool &getSpool()
+        { return spool; };
+
+    protected:
+        Push push;
+        DiskSpool spool;
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQDiskSpool = ofxZeroMQ::DiskSpool;
+using ofxZeroMQSpoolingPush = ofxZeroMQ::SpoolingPush;
+
+#endif /* ofxZeroMQSpool_h */
@@ -0,0 +1,397 @@
+//
+//  ofxZeroMQStreamTransfer.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQStreamTransfer_h
+#define ofxZeroMQStreamTransfer_h
+
+#include "ofxZeroMQ.h"
+
+#include <chrono>
+#include <fstream>
+#include <deque>
+#include <map>
+#include <memory>
+
+#include "ofEvents.h"
+
+// usage:
+//
+// // sender
+// ofxZeroMQStreamSender sender;
+// sender.connect("tcp://localhost:26666");
+// sender.sendFile(ofToDataPath("movie.mov"));
+// sender.update(); // call every frame. reads file chunk only when receiver grants credit
+//
+// // receiver
+// ofxZeroMQStreamReceiver receiver;
+// receiver.setOutputDirectory(ofToDataPath("received")); // if empty, received data is kept as ofBuffer
+// receiver.bind("tcp://*:26666");
+// ofAddListener(receiver.transferCompleted, this, &ofApp::onTransferCompleted);
+// receiver.update(); // call every frame
+
+namespace ofxZeroMQ {
+    namespace detail {
+        /* protocol:
+         * sender -> receiver
+         *   [Begin, id, total_size, chunk_size, name]
+         *   [Chunk, id, offset, data]
+         * receiver -> sender
+         *   [Credit, id, granted_size]
+         *   [Done, id, received_size], received_size is less than total_size if transfer is rejected or aborted
+         *
+         * granted_size is absolute offset which sender may send up to, not added to previous one.
+         * so credit can be sent again after loss without letting sender exceed the window.
+         * chunks are sent in order, and each chunk except last has exactly chunk_size bytes.
+         */
+        enum class stream_command : std::uint8_t {
+            Begin = 0,
+            Chunk = 1,
+            Credit = 2,
+            Done = 3,
+        };
+
+        inline void release_shared_buffer(void *, void *hint)
+        { delete static_cast<std::shared_ptr<ofBuffer> *>(hint); };
+
+        // take only file name part to prevent writing outside of output directory
+        inline std::string sanitize_file_name(const std::string &name) {
+            auto pos = name.find_last_of("/\\");
+            std::string file_name = pos == std::string::npos ? name : name.substr(pos + 1);
+            if(file_name.empty() || file_name == "." || file_name == "..") return "unnamed";
+            return file_name;
+        }
+    }; // detail
+
+    struct StreamTransfer {
+        std::uint64_t id{0};
+        std::string name;
+        std::uint64_t total_size{0};
+        std::uint64_t transferred_size{0};
+        // receiver side. written file path or received data
+        std::string path;
+        ofBuffer buffer;
+
+        float getProgress() const
+        { return total_size == 0 ? 1.0f : static_cast<float>(transferred_size) / total_size; };
+    };
+
+#pragma mark - StreamSender
+    struct StreamSender {
+        void connect(const std::string &address)
+        { dealer.connect(address); };
+        void disconnect(const std::string &address)
+        { dealer.disconnect(address); };
+
+        // chunk_size is applied from next queued transfer
+        void setChunkSize(std::uint32_t size)
+        { chunk_size = 0 < size ? size : 1; };
+        std::uint32_t getChunkSize() const
+        { return chunk_size; };
+
+        // return transfer id. 0 if file can't be opened.
+        std::uint64_t sendFile(const std::string &path, const std::string &name = "") {
+            std::unique_ptr<std::ifstream> file(new std::ifstream(path, std::ios::binary | std::ios::ate));
+            if(!file->is_open()) {
+                ofLogError("ofxZeroMQStreamSender::sendFile") << "can't open " << path;
+                return 0;
+            }
+            Job job;
+            job.info.id = ++last_id;
+            job.info.name = name.empty() ? detail::sanitize_file_name(path) : name;
+            job.info.total_size = static_cast<std::uint64_t>(file->tellg());
+            job.file = std::move(file);
+            jobs.push_back(std::move(job));
+            return last_id;
+        }
+
+        // buffer is shared with sending messages without copy
+        std::uint64_t sendBuffer(ofBuffer buffer, const std::string &name) {
+            Job job;
+            job.info.id = ++last_id;
+            job.info.name = name;
+            job.info.total_size = buffer.size();
+            job.buffer = std::make_shared<ofBuffer>(std::move(buffer));
+            jobs.push_back(std::move(job));
+            return last_id;
+        }
+
+        // receive credits and send chunks as many as granted. never blocks.
+        void update() {
+            MultipartMessage m;
+            while(dealer.receiveMultipart(m)) {
+                if(m.size() < 3) continue;
+                const auto command = m[0].get<detail::stream_command>();
+                const auto id = m[1].get<std::uint64_t>();
+                if(jobs.empty() || jobs.front().info.id != id) continue;
+                Job &job = jobs.front();
+                if(command == detail::stream_command::Credit) {
+                    job.granted_size = std::max(job.granted_size, m[2].get<std::uint64_t>());
+                } else if(command == detail::stream_command::Done) {
+                    job.info.transferred_size = m[2].get<std::uint64_t>();
+                    if(job.info.transferred_size < job.info.total_size) {
+                        ofLogWarning("ofxZeroMQStreamSender") << "transfer " << job.info.name << " is rejected or aborted by receiver";
+                    }
+                    ofNotifyEvent(transferCompleted, job.info, this);
+                    jobs.pop_front();
+                }
+            }
+            if(!jobs.empty()) pump(jobs.front());
+        }
+
+        bool isSending() const
+        { return !jobs.empty(); };
+        std::size_t getNumQueuedTransfers() const
+        { return jobs.size(); };
+        // progress of current transfer
+        float getProgress() const
+        { return jobs.empty() ? 1.0f : jobs.front().info.getProgress(); };
+
+        Dealer &getDealer()
+        { return dealer; };
+
+        ofEvent<StreamTransfer> transferCompleted;
+
+    protected:
+        struct Job {
+            StreamTransfer info;
+            std::unique_ptr<std::ifstream> file;
+            std::shared_ptr<ofBuffer> buffer;
+            std::uint32_t chunk_size{0};
+            std::uint64_t granted_size{0};
+            bool began{false};
+        };
+
+        void pump(Job &job) {
+            if(!job.began) {
+                job.chunk_size = chunk_size;
+                job.began = dealer.sendMultipart(detail::stream_command::Begin,
+                                                 job.info.id,
+                                                 job.info.total_size,
+                                                 job.chunk_size,
+                                                 job.info.name).has_value();
+                if(!job.began) return;
+            }
+            while(job.info.transferred_size < std::min(job.granted_size, job.info.total_size)) {
+                const std::uint64_t offset = job.info.transferred_size;
+                const std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(job.chunk_size, job.info.total_size - offset));
+                zmq::message_t chunk;
+                if(job.buffer) {
+                    chunk.rebuild(job.buffer->getData() + offset,
+                                  size,
+                                  &detail::release_shared_buffer,
+                                  new std::shared_ptr<ofBuffer>(job.buffer));
+                } else {
+                    chunk.rebuild(size);
+                    job.file->seekg(static_cast<std::streamoff>(offset));
+                    job.file->read(static_cast<char *>(chunk.data()), size);
+                    if(!*job.file) {
+                        ofLogError("ofxZeroMQStreamSender") << "failed to read " << job.info.name;
+                        jobs.pop_front();
+                        return;
+                    }
+                }
+                auto sent = dealer.sendMultipart(detail::stream_command::Chunk,
+                                                 job.info.id,
+                                                 offset,
+                                                 std::move(chunk));
+                if(!sent) break;
+                job.info.transferred_size += size;
+            }
+        }
+
+        Dealer dealer;
+        std::deque<Job> jobs;
+        std::uint32_t chunk_size{256 * 1024};
+        std::uint64_t last_id{0};
+    };
+
+#pragma mark - StreamReceiver
+    struct StreamReceiver {
+        void bind(const std::string &address)
+        { router.bind(address); };
+        void unbind(const std::string &address)
+        { router.unbind(address); };
+
+        // number of chunks in flight per transfer. memory bound is window_size * chunk_size.
+        void setWindowSize(std::uint32_t size)
+        { window_size = 0 < size ? size : 1; };
+        std::uint32_t getWindowSize() const
+        { return window_size; };
+
+        // write received chunks to files in this directory. if empty, keep in StreamTransfer::buffer
+        void setOutputDirectory(const std::string &directory)
+        { output_directory = directory; };
+
+        // if no chunk arrives in this time, credit is assumed lost and sent again
+        void setStallTimeout(long timeout_millis)
+        { stall_timeout_millis = timeout_millis; };
+
+        // larger transfers are rejected by Done with received size 0
+        void setMaxTransferSize(std::uint64_t size)
+        { max_transfer_size = size; };
+        std::uint64_t getMaxTransferSize() const
+        { return max_transfer_size; };
+
+        void update() {
+            MultipartMessage m;
+            while(router.receiveMultipart(m)) {
+                if(m.size() < 4) continue;
+                const std::string peer = m[0];
+                const auto command = m[1].get<detail::stream_command>();
+                const auto id = m[2].get<std::uint64_t>();
+                if(command == detail::stream_command::Begin && 6 <= m.size()) {
+                    begin(peer, id, m[3], m[4], m[5]);
+                } else if(command == detail::stream_command::Chunk && 5 <= m.size()) {
+                    write(peer, id, m[3], m.at(4));
+                }
+            }
+            // retry credit which couldn't be sent, or was dropped silently by ROUTER at HWM.
+            // granted size is absolute, so sending it again never enlarges the window
+            const auto now = std::chrono::steady_clock::now();
+            for(auto &pair : transfers) {
+                Transfer &transfer = pair.second;
+                if(std::chrono::milliseconds(stall_timeout_millis) <= now - transfer.last_received) {
+                    transfer.last_received = now;
+                    grant(transfer);
+                } else if(transfer.granted_size <= transfer.info.transferred_size) {
+                    grant(transfer);
+                }
+            }
+        }
+
+        std::size_t getNumActiveTransfers() const
+        { return transfers.size(); };
+
+        Router &getRouter()
+        { return router; };
+
+        ofEvent<StreamTransfer> transferBegan;
+        ofEvent<StreamTransfer> transferCompleted;
+
+    protected:
+        struct Transfer {
+            std::string peer;
+            StreamTransfer info;
+            std::unique_ptr<std::ofstream> file;
+            std::uint32_t chunk_size{0};
+            std::uint64_t granted_size{0};
+            std::chrono::steady_clock::time_point last_received{std::chrono::steady_clock::now()};
+        };
+
+        void begin(const std::string &peer,
+                   std::uint64_t id,
+                   std::uint64_t total_size,
+                   std::uint32_t chunk_size,
+                   const std::string &name)
+        {
+            if(max_transfer_size < total_size) {
+                ofLogWarning("ofxZeroMQStreamReceiver") << "reject " << name << ". size " << total_size << " exceeds " << max_transfer_size;
+                router.sendMultipart(peer, detail::stream_command::Done, id, std::uint64_t{0});
+                return;
+            }
+            if(chunk_size == 0) {
+                ofLogWarning("ofxZeroMQStreamReceiver") << "reject " << name << ". chunk size is 0";
+                router.sendMultipart(peer, detail::stream_command::Done, id, std::uint64_t{0});
+                return;
+            }
+            Transfer &transfer = transfers[key(peer, id)];
+            transfer.peer = peer;
+            transfer.chunk_size = chunk_size;
+            transfer.info.id = id;
+            transfer.info.name = name;
+            transfer.info.total_size = total_size;
+            if(output_directory.empty()) {
+                transfer.info.buffer.allocate(static_cast<std::size_t>(total_size));
+            } else {
+                transfer.info.path = ofFilePath::join(output_directory, detail::sanitize_file_name(name));
+                transfer.file.reset(new std::ofstream(transfer.info.path, std::ios::binary | std::ios::trunc));
+                if(!transfer.file->is_open()) {
+                    ofLogError("ofxZeroMQStreamReceiver") << "can't open " << transfer.info.path;
+                }
+            }
+            ofNotifyEvent(transferBegan, transfer.info, this);
+            grant(transfer);
+            if(total_size == 0) finish(peer, id, transfer);
+        }
+
+        void write(const std::string &peer,
+                   std::uint64_t id,
+                   std::uint64_t offset,
+                   const zmq::message_t &chunk)
+        {
+            auto it = transfers.find(key(peer, id));
+            if(it == transfers.end()) return;
+            Transfer &transfer = it->second;
+            // chunks arrive in order on one connection, so anything else is broken sender
+            const std::uint64_t expected_size = std::min<std::uint64_t>(transfer.chunk_size, transfer.info.total_size - transfer.info.transferred_size);
+            if(offset != transfer.info.transferred_size || chunk.size() != expected_size) {
+                ofLogWarning("ofxZeroMQStreamReceiver") << "unexpected chunk of " << chunk.size() << " bytes at " << offset << ". abort transfer " << transfer.info.name;
+                abort(peer, id, transfer);
+                return;
+            }
+            if(transfer.file) {
+                transfer.file->seekp(static_cast<std::streamoff>(offset));
+                transfer.file->write(static_cast<const char *>(chunk.data()), chunk.size());
+            } else {
+                std::memcpy(transfer.info.buffer.getData() + offset, chunk.data(), chunk.size());
+            }
+            transfer.info.transferred_size += chunk.size();
+            transfer.last_received = std::chrono::steady_clock::now();
+
+            if(transfer.info.total_size <= transfer.info.transferred_size) {
+                finish(peer, id, transfer);
+                return;
+            }
+            // grant in batch to reduce control messages
+            const std::uint64_t batch = std::max<std::uint32_t>(1, window_size / 4) * static_cast<std::uint64_t>(transfer.chunk_size);
+            if(transfer.granted_size + batch <= grantable_size(transfer)) grant(transfer);
+        }
+
+        // window_size chunks ahead of received size
+        std::uint64_t grantable_size(const Transfer &transfer) const {
+            const std::uint64_t window = static_cast<std::uint64_t>(window_size) * transfer.chunk_size;
+            return std::min(transfer.info.total_size, transfer.info.transferred_size + window);
+        }
+
+        // granted size is updated only if sent. otherwise retried by update
+        void grant(Transfer &transfer) {
+            const std::uint64_t size = grantable_size(transfer);
+            if(router.sendMultipart(transfer.peer, detail::stream_command::Credit, transfer.info.id, size)) {
+                transfer.granted_size = size;
+            }
+        }
+
+        void finish(const std::string &peer, std::uint64_t id, Transfer &transfer) {
+            if(transfer.file) transfer.file->close();
+            router.sendMultipart(peer, detail::stream_command::Done, id, transfer.info.transferred_size);
+            ofNotifyEvent(transferCompleted, transfer.info, this);
+            transfers.erase(key(peer, id));
+        }
+
+        // sender stops by Done with received size. transferCompleted is not notified
+        void abort(const std::string &peer, std::uint64_t id, Transfer &transfer) {
+            if(transfer.file) transfer.file->close();
+            router.sendMultipart(peer, detail::stream_command::Done, id, transfer.info.transferred_size);
+            transfers.erase(key(peer, id));
+        }
+
+        static std::string key(const std::string &peer, std::uint64_t id)
+        { return peer + ":" + std::to_string(id); };
+
+        Router router;
+        std::map<std::string, Transfer> transfers;
+        std::uint32_t window_size{16};
+        std::string output_directory;
+        std::uint64_t max_transfer_size{1ull << 30};
+        long stall_timeout_millis{1000};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQStreamTransfer = ofxZeroMQ::StreamTransfer;
+using ofxZeroMQStreamSender = ofxZeroMQ::StreamSender;
+using ofxZeroMQStreamReceiver = ofxZeroMQ::StreamReceiver;
+
+#endif /* ofxZeroMQStreamTransfer_h */
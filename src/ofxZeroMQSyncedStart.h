@@ -0,0 +1,232 @@
+//
+//  ofxZeroMQSyncedStart.h
+//
+//  Created by 2bit on 2026/10/19.
+//
+
+#ifndef ofxZeroMQSyncedStart_h
+#define ofxZeroMQSyncedStart_h
+
+#include "ofxZeroMQ.h"
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <random>
+
+#include "ofEvents.h"
+
+// usage:
+//
+// // publisher
+// ofxZeroMQSyncedPublisher pub;
+// pub.bind("tcp://*:26666");
+// pub.waitForSubscribers({"left", "right"}, 5000); // instead of sleeping
+// pub.sendMultipart("scene", "start"); // reaches both
+//
+// // subscriber
+// ofxZeroMQSyncedSubscriber sub{"left"};
+// sub.addFilter("scene"); // before connect
+// sub.connect("tcp://server:26666");
+// sub.waitForPublisher(5000); // optional. true after welcome of publisher is received
+// ofxZeroMQMultipartMessage m;
+// while(sub.receiveMultipart(m)) { ... }
+//
+// topic "$sync/welcome" and topics beginning with byte 0xff are reserved.
+
+namespace ofxZeroMQ {
+    namespace detail {
+        /* subscriber -> publisher  subscription [0xff][sync/ready/][name]
+         * publisher -> subscriber  ZMQ_XPUB_WELCOME_MSG [$sync/welcome] on attach
+         *
+         * SUB sends its subscriptions in byte order on (re)connect,
+         * so ready subscription beginning with 0xff is sent after all other filters.
+         */
+        static constexpr const char *sync_ready_prefix = "\xff" "sync/ready/";
+        static constexpr const char *sync_welcome_topic = "$sync/welcome";
+
+        inline std::string random_subscriber_name() {
+            std::random_device device;
+            std::mt19937_64 engine{(static_cast<std::uint64_t>(device()) << 32) | device()};
+            char buf[17];
+            std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(engine()));
+            return buf;
+        }
+    }; // detail
+
+#pragma mark - SyncedPublisher
+    // XPUB which knows which subscribers are attached by their ready subscriptions.
+    // when ready subscription arrives, other filters of same subscriber are already applied.
+    struct SyncedPublisher {
+        SyncedPublisher() {
+            const std::string welcome = detail::sync_welcome_topic;
+            xpub.getRawSocket().setsockopt(ZMQ_XPUB_WELCOME_MSG, welcome.data(), welcome.size());
+        }
+
+        void bind(const std::string &address)
+        { xpub.bind(address); };
+        void unbind(const std::string &address)
+        { xpub.unbind(address); };
+
+        // apply subscription notifications. called by send too
+        void update() {
+            MultipartMessage m;
+            while(xpub.receiveMultipart(m)) {
+                if(m.empty() || m.at(0).size() < 1) continue;
+                const char *data = static_cast<const char *>(m.at(0).data());
+                const std::string filter{data + 1, data + m.at(0).size()};
+                const std::size_t prefix_length = std::strlen(detail::sync_ready_prefix);
+                if(filter.compare(0, prefix_length, detail::sync_ready_prefix) != 0) continue;
+                const std::string name = filter.substr(prefix_length);
+                if(data[0] == 1) {
+                    if(subscribers.insert(name).second) ofNotifyEvent(subscriberAttached, name, this);
+                } else {
+                    if(0 < subscribers.erase(name)) ofNotifyEvent(subscriberDetached, name, this);
+                }
+            }
+        }
+
+        // return false if timed out
+        bool waitForSubscribers(std::size_t num, long timeout_millis)
+        { return wait_until(timeout_millis, [this, num] { return num <= subscribers.size(); }); };
+
+        bool waitForSubscribers(const std::vector<std::string> &names, long timeout_millis) {
+            return wait_until(timeout_millis, [this, &names] {
+                for(const auto &name : names) if(!isAttached(name)) return false;
+                return true;
+            });
+        }
+
+        bool isAttached(const std::string &name) const
+        { return subscribers.find(name) != subscribers.end(); };
+        std::size_t getNumSubscribers() const
+        { return subscribers.size(); };
+        const std::set<std::string> &getSubscribers() const
+        { return subscribers; };
+
+        template <typename ... types>
+        zmq::send_result_t sendMultipart(types && ... data) {
+            update();
+            return xpub.sendMultipart(std::forward<types>(data) ...);
+        }
+
+        template <typename ... types>
+        zmq::send_result_t send(types && ... data) {
+            update();
+            return xpub.send(std::forward<types>(data) ...);
+        }
+
+        XPublisher &getSocket()
+        { return xpub; };
+
+        ofEvent<const std::string> subscriberAttached;
+        // subscriber disconnected (or its ready subscription is unsubscribed)
+        ofEvent<const std::string> subscriberDetached;
+
+    protected:
+        template <typename predicate_type>
+        bool wait_until(long timeout_millis, predicate_type predicate) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_millis);
+            while(true) {
+                update();
+                if(predicate()) return true;
+                const auto now = std::chrono::steady_clock::now();
+                if(deadline <= now) break;
+                xpub.hasWaitingMessage(static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + 1);
+            }
+            ofLogWarning("ofxZeroMQSyncedPublisher") << "timed out. " << subscribers.size() << " subscribers are attached";
+            return false;
+        }
+
+        XPublisher xpub;
+        std::set<std::string> subscribers;
+    };
+
+#pragma mark - SyncedSubscriber
+    struct SyncedSubscriber {
+        // name identifies this subscriber on publisher. random if empty
+        SyncedSubscriber(const std::string &name = "")
+        : name(name.empty() ? detail::random_subscriber_name() : name)
+        {};
+
+        // filters have to be added before connect, so publisher can know they are applied
+        void addFilter(const std::string &filter) {
+            sub.addFilter(filter);
+            has_filter = true;
+        }
+        bool removeFilter(const std::string &filter)
+        { return sub.removeFilter(filter); };
+
+        void connect(const std::string &address) {
+            if(!is_ready_subscribed) {
+                if(!has_filter) sub.addFilter("");
+                sub.addFilter(detail::sync_welcome_topic);
+                sub.addFilter(detail::sync_ready_prefix + name);
+                is_ready_subscribed = true;
+            }
+            sub.connect(address);
+        }
+        void disconnect(const std::string &address)
+        { sub.disconnect(address); };
+
+        // return false if no welcome is received in timeout. other messages received meanwhile are kept
+        bool waitForPublisher(long timeout_millis, std::size_t num_publishers = 1) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_millis);
+            MultipartMessage m;
+            while(num_welcomes < num_publishers) {
+                const auto now = std::chrono::steady_clock::now();
+                if(deadline <= now) return false;
+                if(!sub.hasWaitingMessage(static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + 1)) continue;
+                while(receive_raw(m)) pending.push_back(std::move(m));
+            }
+            return true;
+        }
+
+        bool receiveMultipart(MultipartMessage &message, ReceiveFlag flags = ReceiveFlag{}) {
+            if(!pending.empty()) {
+                message = std::move(pending.front());
+                pending.pop_front();
+                return true;
+            }
+            return receive_raw(message, flags);
+        }
+
+        // number of welcomes received. increased again when publisher restarts
+        std::size_t getNumWelcomes() const
+        { return num_welcomes; };
+        bool isAttached() const
+        { return 0 < num_welcomes; };
+        const std::string &getName() const
+        { return name; };
+
+        Subscriber &getSocket()
+        { return sub; };
+
+    protected:
+        // welcome messages are consumed here
+        bool receive_raw(MultipartMessage &message, ReceiveFlag flags = ReceiveFlag{}) {
+            while(sub.receiveMultipart(message, flags)) {
+                if(message.size() == 1 && message.at(0).size() == std::strlen(detail::sync_welcome_topic)
+                   && std::memcmp(message.at(0).data(), detail::sync_welcome_topic, message.at(0).size()) == 0)
+                {
+                    ++num_welcomes;
+                    continue;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        Subscriber sub;
+        std::string name;
+        std::deque<MultipartMessage> pending;
+        std::size_t num_welcomes{0};
+        bool has_filter{false};
+        bool is_ready_subscribed{false};
+    };
+}; // ofxZeroMQ
+
+using ofxZeroMQSyncedPublisher = ofxZeroMQ::SyncedPublisher;
+using ofxZeroMQSyncedSubscriber = ofxZeroMQ::SyncedSubscriber;
+
+#endif /* ofxZeroMQSyncedStart_h */